@@ -0,0 +1,86 @@
+// Copyright (c) 2025 Klemens D. Morgenstern
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include <boost/cobalt.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace boost;
+constexpr std::size_t n = 10'000ull;
+// the amount of threads running at the same time.
+constexpr std::size_t batch = 256ull;
+
+cobalt::thread worker()
+{
+  co_return;
+}
+
+cobalt::task<void> pool_worker()
+{
+  co_return;
+}
+
+cobalt::task<void> atest()
+{
+  std::vector<cobalt::thread> threads;
+  threads.reserve(batch);
+  for (std::size_t i = 0u; i < n; i += batch)
+  {
+    for (std::size_t j = 0u; j < batch; j++)
+      threads.push_back(worker());
+    for (auto & t : threads)
+      co_await t;
+    threads.clear();
+  }
+}
+
+cobalt::task<void> ptest()
+{
+  cobalt::thread_pool pool;
+  for (std::size_t i = 0u; i < n; i++)
+    co_await pool.run(&pool_worker);
+}
+
+void stest()
+{
+  std::vector<std::thread> threads;
+  threads.reserve(batch);
+  for (std::size_t i = 0u; i < n; i += batch)
+  {
+    for (std::size_t j = 0u; j < batch; j++)
+      threads.emplace_back([]{});
+    for (auto & t : threads)
+      t.join();
+    threads.clear();
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  {
+    auto start = std::chrono::steady_clock::now();
+    cobalt::run(atest());
+    auto end = std::chrono::steady_clock::now();
+    printf("cobalt::thread : %ld ms\n", std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+  }
+
+  {
+    auto start = std::chrono::steady_clock::now();
+    cobalt::run(ptest());
+    auto end = std::chrono::steady_clock::now();
+    printf("thread_pool    : %ld ms\n", std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+  }
+
+  {
+    auto start = std::chrono::steady_clock::now();
+    stest();
+    auto end = std::chrono::steady_clock::now();
+    printf("std::thread    : %ld ms\n", std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+  }
+
+  return 0;
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Klemens D. Morgenstern
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include <boost/cobalt.hpp>
+#include <boost/asio.hpp>
+
+using namespace boost;
+constexpr std::size_t n = 5'000'000ull;
+
+// the op completes before the timeout, which is the common case for a read with a timeout.
+cobalt::task<void> race_test()
+{
+  auto exec = co_await cobalt::this_coro::executor;
+  for (std::size_t i = 0u; i < n; i++)
+  {
+    asio::steady_timer tim{exec, std::chrono::seconds(10)};
+    co_await cobalt::race(asio::post(exec, cobalt::use_op), tim.async_wait(cobalt::use_op));
+  }
+}
+
+cobalt::task<void> with_timeout_test()
+{
+  auto exec = co_await cobalt::this_coro::executor;
+  for (std::size_t i = 0u; i < n; i++)
+    co_await cobalt::with_timeout(asio::post(exec, cobalt::use_op), std::chrono::seconds(10));
+}
+
+cobalt::task<void> plain_test()
+{
+  auto exec = co_await cobalt::this_coro::executor;
+  for (std::size_t i = 0u; i < n; i++)
+    co_await asio::post(exec, cobalt::use_op);
+}
+
+int main(int argc, char * argv[])
+{
+  {
+    auto start = std::chrono::steady_clock::now();
+    cobalt::run(race_test());
+    auto end = std::chrono::steady_clock::now();
+    printf("race         : %ld ms\n", std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+  }
+
+  {
+    auto start = std::chrono::steady_clock::now();
+    cobalt::run(with_timeout_test());
+    auto end = std::chrono::steady_clock::now();
+    printf("with_timeout : %ld ms\n", std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+  }
+
+  {
+    auto start = std::chrono::steady_clock::now();
+    cobalt::run(plain_test());
+    auto end = std::chrono::steady_clock::now();
+    printf("no timeout   : %ld ms\n", std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+  }
+
+  return 0;
+}
@@ -8,27 +8,43 @@
 #ifndef BOOST_COBALT_HPP
 #define BOOST_COBALT_HPP
 
+#include <boost/cobalt/as_completed.hpp>
 #include <boost/cobalt/async_for.hpp>
+#include <boost/cobalt/barrier.hpp>
 #include <boost/cobalt/channel.hpp>
 #include <boost/cobalt/concepts.hpp>
 #include <boost/cobalt/config.hpp>
 #include <boost/cobalt/detached.hpp>
 #include <boost/cobalt/error.hpp>
+#include <boost/cobalt/event.hpp>
 #include <boost/cobalt/gather.hpp>
 #include <boost/cobalt/generator.hpp>
+#include <boost/cobalt/hedge.hpp>
+#include <boost/cobalt/ipc_channel.hpp>
 #include <boost/cobalt/join.hpp>
+#include <boost/cobalt/latch.hpp>
 #include <boost/cobalt/main.hpp>
+#include <boost/cobalt/mutex.hpp>
+#include <boost/cobalt/offload.hpp>
 #include <boost/cobalt/op.hpp>
+#include <boost/cobalt/parallel.hpp>
 #include <boost/cobalt/promise.hpp>
 #include <boost/cobalt/run.hpp>
 #include <boost/cobalt/race.hpp>
+#include <boost/cobalt/selector.hpp>
+#include <boost/cobalt/semaphore.hpp>
+#include <boost/cobalt/shard.hpp>
 #include <boost/cobalt/spawn.hpp>
+#include <boost/cobalt/switch_to.hpp>
 #include <boost/cobalt/task.hpp>
 #include <boost/cobalt/this_coro.hpp>
 #include <boost/cobalt/this_thread.hpp>
 #include <boost/cobalt/thread.hpp>
+#include <boost/cobalt/thread_pool.hpp>
 #include <boost/cobalt/wait_group.hpp>
+#include <boost/cobalt/when_k.hpp>
 #include <boost/cobalt/with.hpp>
+#include <boost/cobalt/with_timeout.hpp>
 
 #endif //BOOST_COBALT_HPP
 
@@ -0,0 +1,33 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_AS_COMPLETED_HPP
+#define BOOST_COBALT_AS_COMPLETED_HPP
+
+#include <boost/cobalt/concepts.hpp>
+#include <boost/cobalt/detail/as_completed.hpp>
+
+#include <limits>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+// Await the elements of the range, with at most limit of them at a time,
+// and yield {index, result} in the order of completion. Yields std::nullopt once all are done.
+template<typename AwaitableRange>
+  requires awaitable<std::decay_t<decltype(*std::begin(std::declval<AwaitableRange&>()))>>
+auto as_completed(AwaitableRange && aws,
+                  std::size_t limit = (std::numeric_limits<std::size_t>::max)())
+// end::outline[]
+{
+  return detail::as_completed_impl<AwaitableRange>(static_cast<AwaitableRange&&>(aws), limit);
+}
+
+}
+
+#endif //BOOST_COBALT_AS_COMPLETED_HPP
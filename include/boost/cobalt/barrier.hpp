@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_BARRIER_HPP
+#define BOOST_COBALT_BARRIER_HPP
+
+#include <boost/cobalt/this_thread.hpp>
+#include <boost/cobalt/detail/sync_waiter.hpp>
+
+#include <tuple>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+// A reusable barrier: once the expected amount of coroutines arrived, all get resumed and the next phase starts.
+struct barrier
+{
+  explicit barrier(std::size_t expected, executor exec = this_thread::get_executor())
+      : executor_(std::move(exec)), expected_(expected) {}
+  // not movable.
+  barrier(barrier && rhs) noexcept = delete;
+  barrier & operator=(barrier && lhs) noexcept = delete;
+  // Destroys the waiting coroutines, like a channel.
+  BOOST_COBALT_DECL ~barrier();
+
+  using executor_type = executor;
+  const executor_type & get_executor() {return executor_;}
+
+  // The amount of arrivals required to complete the current phase.
+  std::size_t expected() const {return expected_;}
+  // The amount of coroutines waiting in the current phase.
+  std::size_t arrived() const {return arrived_;}
+  // The amount of completed phases.
+  std::size_t phase() const {return phase_;}
+
+  // Reduce the expected count for this and all following phases, without waiting.
+  BOOST_COBALT_DECL void arrive_and_drop();
+
+  // end::outline[]
+ private:
+  struct arrive_op : detail::sync_waiter
+  {
+    barrier * bar;
+
+    arrive_op(barrier * bar, const boost::source_location & loc)
+        : detail::sync_waiter(bar->executor_, loc), bar(bar)
+    {
+      owner = bar;
+      // a waiter that got cancelled while queued didn't arrive.
+      on_cancel = +[](void * p) {static_cast<barrier*>(p)->arrived_--;};
+    }
+
+    // the arrival happens in await_suspend, so that the last one can complete the phase.
+    bool await_ready() const {return false;}
+
+    template<typename Promise>
+    BOOST_COBALT_MSVC_NOINLINE
+    std::coroutine_handle<void> await_suspend(std::coroutine_handle<Promise> h)
+    {
+      if (cancelled)
+        return h;
+      if (bar->arrived_ + 1u >= bar->expected_)
+      {
+        direct = true;
+        bar->complete_phase_();
+        return h;
+      }
+      bar->arrived_++;
+      enqueue(h, bar->waiters_);
+      return std::noop_coroutine();
+    }
+
+    void await_resume() {result().value(loc);}
+    std::tuple<system::error_code> await_resume(const struct as_tuple_tag & ) {return result().error();}
+    system::result<void> await_resume(const struct as_result_tag &) {return result();}
+  };
+
+  BOOST_COBALT_DECL void complete_phase_();
+
+  executor_type executor_;
+  std::size_t expected_;
+  std::size_t arrived_ = 0u;
+  std::size_t phase_ = 0u;
+  detail::sync_waiter_queue waiters_;
+ public:
+  [[nodiscard]] arrive_op arrive_and_wait(const boost::source_location & loc = BOOST_CURRENT_LOCATION) {return {this, loc};}
+  /*
+  // tag::outline[]
+  // an awaitable that yields void
+  using __arrive_op__ = __unspecified__;
+
+  // Arrive at the barrier & wait for the phase to complete.
+  __arrive_op__ arrive_and_wait();
+  // end::outline[]
+   */
+  // tag::outline[]
+};
+// end::outline[]
+
+}
+
+#endif //BOOST_COBALT_BARRIER_HPP
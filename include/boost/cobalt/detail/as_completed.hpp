@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_DETAIL_AS_COMPLETED_HPP
+#define BOOST_COBALT_DETAIL_AS_COMPLETED_HPP
+
+#include <boost/cobalt/channel.hpp>
+#include <boost/cobalt/generator.hpp>
+#include <boost/cobalt/promise.hpp>
+#include <boost/cobalt/this_coro.hpp>
+#include <boost/cobalt/detail/await_result_helper.hpp>
+
+#include <boost/system/result.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace boost::cobalt::detail
+{
+
+template<typename Range>
+struct as_completed_state
+{
+  using element_type = std::decay_t<decltype(*std::begin(std::declval<Range&>()))>;
+  using result_type  = system::result<co_await_result_t<element_type>, std::exception_ptr>;
+  using value_type   = std::pair<std::size_t, result_type>;
+
+  as_completed_state(Range && range, std::size_t limit, executor exec)
+      : range(static_cast<Range&&>(range)),
+        itr(std::begin(this->range)),
+        limit((std::max)(std::size_t(1u), (std::min)(limit, static_cast<std::size_t>(std::size(this->range))))),
+        exec(exec),
+        // a full buffer suspends the workers until the results get read.
+        results(this->limit, exec)
+  {
+  }
+
+  Range range;
+  decltype(std::begin(std::declval<Range&>())) itr;
+  std::size_t limit;
+  executor exec;
+  std::size_t started = 0u, received = 0u;
+  channel<value_type> results;
+
+  bool done() const {return itr == std::end(range) && received == started;}
+};
+
+// The workers pull the next awaitable from the range, so there's one frame per worker instead of one per element.
+template<typename Range>
+promise<void> as_completed_worker(asio::executor_arg_t, executor, std::shared_ptr<as_completed_state<Range>> st)
+{
+  using state_t = as_completed_state<Range>;
+  using a_t = std::conditional_t<std::is_lvalue_reference_v<Range>,
+                                 typename state_t::element_type &,
+                                 typename state_t::element_type &&>;
+
+  while (st->itr != std::end(st->range))
+  {
+    const auto idx = st->started++;
+    auto && aw = *st->itr;
+    ++st->itr;
+
+    std::optional<typename state_t::result_type> res;
+    try
+    {
+      if constexpr (std::is_void_v<co_await_result_t<typename state_t::element_type>>)
+      {
+        co_await static_cast<a_t>(aw);
+        res.emplace(system::in_place_value);
+      }
+      else
+        res.emplace(system::in_place_value, co_await static_cast<a_t>(aw));
+    }
+    catch (...)
+    {
+      res.emplace(system::in_place_error, std::current_exception());
+    }
+
+    co_await st->results.write(typename state_t::value_type{idx, std::move(*res)});
+  }
+}
+
+template<typename Range>
+generator<std::optional<typename as_completed_state<Range>::value_type>>
+as_completed_impl(Range range, std::size_t limit)
+{
+  using state_t = as_completed_state<Range>;
+  // shared with the workers, in case the generator gets destroyed before they're done.
+  auto st = std::make_shared<state_t>(static_cast<Range&&>(range), limit, co_await this_coro::executor);
+
+  std::vector<promise<void>> workers;
+  workers.reserve(st->limit);
+  for (std::size_t i = 0u; i < st->limit && st->itr != std::end(st->range); i++)
+    workers.push_back(as_completed_worker<Range>(asio::executor_arg, st->exec, st));
+
+  while (!st->done())
+  {
+    auto res = co_await st->results.read();
+    st->received++;
+    co_yield std::optional<typename state_t::value_type>(std::move(res));
+  }
+
+  for (auto & w : workers)
+    co_await w;
+  co_return std::nullopt;
+}
+
+}
+
+#endif //BOOST_COBALT_DETAIL_AS_COMPLETED_HPP
@@ -368,6 +368,8 @@ struct generator_promise
   using executor_type = executor;
   executor_type exec;
   const executor_type & get_executor() const {return exec;}
+  // used by switch_to
+  void set_executor(executor_type exec_) {exec = std::move(exec_);}
 
   template<typename ... Args>
   generator_promise(Args & ...args)
@@ -0,0 +1,268 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_DETAIL_HEDGE_HPP
+#define BOOST_COBALT_DETAIL_HEDGE_HPP
+
+#include <boost/cobalt/op.hpp>
+#include <boost/cobalt/detail/await_result_helper.hpp>
+#include <boost/cobalt/detail/fork.hpp>
+#include <boost/cobalt/detail/forward_cancellation.hpp>
+#include <boost/cobalt/detail/util.hpp>
+#include <boost/cobalt/detail/wrapper.hpp>
+
+#include <boost/asio/basic_waitable_timer.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/system/result.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <chrono>
+#include <coroutine>
+#include <optional>
+#include <utility>
+
+namespace boost::cobalt::detail
+{
+
+template<typename Factory>
+struct hedge_impl
+{
+  Factory factory;
+  std::chrono::steady_clock::duration delay;
+  std::size_t max_attempts;
+
+  using source_type = std::invoke_result_t<Factory&>;
+  using awaitable_type = co_awaitable_type<source_type>;
+  using result_type = co_await_result_t<source_type>;
+  // the index of the winning attempt, paired with its result.
+  using value_type = std::conditional_t<std::is_void_v<result_type>,
+                                        std::size_t,
+                                        std::pair<std::size_t, result_type>>;
+
+  // enough for two attempts & the timer, so the common case doesn't allocate.
+  constexpr static std::size_t buffer_size = 1024u + 2u * (512u + sizeof(source_type) + sizeof(awaitable_type));
+
+  struct awaitable : fork::static_shared_state<buffer_size>
+  {
+    awaitable(Factory & factory, std::chrono::steady_clock::duration delay, std::size_t max_attempts)
+        : factory(factory), delay(delay), max_attempts(max_attempts)
+    {
+    }
+
+    Factory & factory;
+    std::chrono::steady_clock::duration delay;
+    std::size_t max_attempts;
+
+    std::size_t started = 0u, active = 0u;
+    bool cancelled = false;
+    std::optional<std::size_t> winner;
+    std::optional<void_as_monostate<result_type>> result;
+    std::exception_ptr error;
+
+    // A cancellation signal living in the frame of a running fork, linked into the list of running forks.
+    struct running_
+    {
+      awaitable & this_;
+      asio::cancellation_signal signal;
+      running_ * next;
+
+      running_(awaitable & this_) : this_(this_), next(std::exchange(this_.running, this)) {}
+      ~running_()
+      {
+        auto p = &this_.running;
+        while (*p != this)
+          p = &(*p)->next;
+        *p = next;
+      }
+    };
+    running_ * running = nullptr;
+
+    void cancel_all(asio::cancellation_type ct = asio::cancellation_type::all)
+    {
+      for (auto r = running; r != nullptr;)
+      {
+        auto nx = r->next;
+        r->signal.emit(ct);
+        r = nx;
+      }
+    }
+
+    bool can_start() const {return !winner && !cancelled && started < max_attempts;}
+
+    template<typename ... Value>
+    void succeed(std::size_t idx, Value && ... value)
+    {
+      active--;
+      if (winner)
+        return;
+      winner = idx;
+      result.emplace(std::forward<Value>(value)...);
+      cancel_all();
+    }
+
+    void fail(std::exception_ptr ep)
+    {
+      active--;
+      if (!error)
+        error = std::move(ep);
+      // nothing running anymore, so don't wait for the delay to start the next attempt.
+      if (active == 0u && can_start())
+        start_attempt();
+      else if (active == 0u)
+        cancel_all(); // the timer
+    }
+
+    void start_attempt()
+    {
+      active++;
+      attempt_impl(*this, started++).release();
+    }
+
+    static detail::fork attempt_impl(awaitable & this_, std::size_t idx)
+    {
+      running_ r{this_};
+      co_await r.signal.slot();
+      try
+      {
+        auto src = this_.factory();
+        auto && aw = get_awaitable_type(std::move(src));
+        if (!aw.await_ready())
+        {
+          if constexpr (std::is_void_v<result_type>)
+          {
+            co_await aw;
+            this_.succeed(idx);
+          }
+          else
+            this_.succeed(idx, co_await aw);
+        }
+        else
+        {
+          if constexpr (std::is_void_v<result_type>)
+          {
+            aw.await_resume();
+            this_.succeed(idx);
+          }
+          else
+            this_.succeed(idx, aw.await_resume());
+        }
+      }
+      catch (...)
+      {
+        this_.fail(std::current_exception());
+      }
+    }
+
+    static detail::fork timer_impl(awaitable & this_)
+    {
+      running_ r{this_};
+      co_await r.signal.slot();
+      asio::basic_waitable_timer<std::chrono::steady_clock,
+                                 asio::wait_traits<std::chrono::steady_clock>,
+                                 executor> tim{this_.get_executor()};
+      try
+      {
+        while (this_.can_start() && this_.active > 0u)
+        {
+          tim.expires_after(this_.delay);
+          auto w = tim.async_wait(use_op);
+          co_await w;
+          if (this_.can_start())
+            this_.start_attempt();
+        }
+      }
+      catch (...)
+      {
+        // cancelled, because an attempt won or all failed.
+      }
+    }
+
+    constexpr static bool await_ready() {return false;}
+
+    template<typename H>
+    auto await_suspend(
+        std::coroutine_handle<H> h
+#if defined(BOOST_ASIO_ENABLE_HANDLER_TRACKING)
+        , const boost::source_location & loc = BOOST_CURRENT_LOCATION
+#endif
+    )
+    {
+#if defined(BOOST_ASIO_ENABLE_HANDLER_TRACKING)
+      this->loc = loc;
+#endif
+      this->exec = detail::get_executor(h);
+
+      if (max_attempts > 0u)
+      {
+        start_attempt();
+        if (max_attempts > 1u && !winner && active > 0u)
+          timer_impl(*this).release();
+      }
+
+      if (!this->outstanding_work()) // already done, resume right away.
+        return false;
+
+      // arm the cancel
+      assign_cancellation(
+          h,
+          [&](asio::cancellation_type ct)
+          {
+            cancelled = true;
+            cancel_all(ct);
+          });
+
+      this->coro.reset(h.address());
+      return true;
+    }
+
+    std::exception_ptr get_error() const
+    {
+      if (winner)
+        return nullptr;
+      // no attempt was allowed.
+      return error ? error : std::make_exception_ptr(system::system_error(asio::error::invalid_argument, "hedge"));
+    }
+
+    auto make_result()
+    {
+      if constexpr (std::is_void_v<result_type>)
+        return *winner;
+      else
+        return value_type(*winner, *std::move(result));
+    }
+
+    auto await_resume(const as_tuple_tag &)
+    {
+      if (auto ep = get_error())
+        return std::make_tuple(ep, value_type{});
+      return std::make_tuple(std::exception_ptr(), make_result());
+    }
+
+    auto await_resume(const as_result_tag &)
+    {
+      using rt = system::result<value_type, std::exception_ptr>;
+      if (auto ep = get_error())
+        return rt(system::in_place_error, ep);
+      return rt(system::in_place_value, make_result());
+    }
+
+    BOOST_COBALT_MSVC_NOINLINE
+    auto await_resume()
+    {
+      if (auto ep = get_error())
+        std::rethrow_exception(ep);
+      return make_result();
+    }
+  };
+
+  awaitable operator co_await() && {return awaitable{factory, delay, max_attempts};}
+};
+
+}
+
+#endif //BOOST_COBALT_DETAIL_HEDGE_HPP
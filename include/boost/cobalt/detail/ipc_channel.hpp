@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_DETAIL_IPC_CHANNEL_HPP
+#define BOOST_COBALT_DETAIL_IPC_CHANNEL_HPP
+
+#include <boost/cobalt/config.hpp>
+#include <boost/cobalt/op.hpp>
+#include <boost/cobalt/this_thread.hpp>
+
+#include <boost/asio/posix/basic_stream_descriptor.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace boost::cobalt
+{
+
+struct ipc_ring;
+
+namespace detail
+{
+
+// The layout at the start of the shared mapping, followed by the slots.
+// head & tail count up forever, so head - tail is the amount of elements in the ring.
+struct ipc_ring_header
+{
+  alignas(64) std::atomic<std::uint64_t> head{0u}; // only written by the producer
+  alignas(64) std::atomic<std::uint64_t> tail{0u}; // only written by the consumer
+  alignas(64) std::atomic<std::uint32_t> reader_waiting{0u};
+  std::atomic<std::uint32_t> writer_waiting{0u};
+  std::atomic<std::uint32_t> closed{0u};
+  std::uint64_t capacity;
+  std::uint64_t element_size;
+
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+  static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+};
+
+inline void ipc_cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+struct BOOST_SYMBOL_VISIBLE ipc_channel_base
+{
+  // How often a read or write retries before waiting for the other side to wake it up.
+  std::size_t spin = 0u;
+
+  bool is_open() const {return header_->closed.load(std::memory_order_acquire) == 0u;}
+  // Close the channel, the reader still gets the elements that have been written.
+  BOOST_COBALT_DECL void close();
+
+ protected:
+  BOOST_COBALT_DECL ipc_channel_base(ipc_ring & ring, std::size_t element_size, const executor & exec);
+
+  bool try_write_(const void * data)
+  {
+    auto & h = *header_;
+    const auto head = h.head.load(std::memory_order_relaxed);
+    if (head - h.tail.load(std::memory_order_acquire) >= h.capacity)
+      return false;
+    std::memcpy(slots_ + (head % h.capacity) * h.element_size, data, h.element_size);
+    h.head.store(head + 1u, std::memory_order_release);
+    // pairs with the fence in wait_op_, so either the reader sees the element or we see it waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (h.reader_waiting.load(std::memory_order_relaxed) != 0u)
+      notify_(readable_);
+    return true;
+  }
+
+  bool try_read_(void * data)
+  {
+    auto & h = *header_;
+    const auto tail = h.tail.load(std::memory_order_relaxed);
+    if (h.head.load(std::memory_order_acquire) == tail)
+      return false;
+    std::memcpy(data, slots_ + (tail % h.capacity) * h.element_size, h.element_size);
+    h.tail.store(tail + 1u, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (h.writer_waiting.load(std::memory_order_relaxed) != 0u)
+      notify_(writable_);
+    return true;
+  }
+
+  template<typename Try>
+  bool spin_(Try && try_)
+  {
+    for (std::size_t i = 0u; i < spin; i++)
+    {
+      ipc_cpu_relax();
+      if (try_())
+        return true;
+    }
+    return false;
+  }
+
+  using descriptor_type = asio::posix::basic_stream_descriptor<executor>;
+
+  // Waits until the ring isn't empty (reading) or full (writing) anymore or got closed.
+  struct BOOST_COBALT_DECL wait_op_ final : op<system::error_code>
+  {
+    void initiate(completion_handler<system::error_code> h) final override;
+
+    wait_op_(ipc_channel_base & chan, bool reading) : chan_(chan), reading_(reading) {}
+    ~wait_op_() = default;
+   private:
+    ipc_channel_base & chan_;
+    bool reading_;
+  };
+
+  struct BOOST_COBALT_DECL write_op_ final : op<system::error_code>
+  {
+    void ready(handler<system::error_code> h) final override;
+    void initiate(completion_handler<system::error_code> h) final override;
+
+    write_op_(ipc_channel_base & chan, const void * data) : chan_(chan), data_(data) {}
+    ~write_op_() = default;
+   private:
+    ipc_channel_base & chan_;
+    const void * data_;
+  };
+
+  BOOST_COBALT_DECL static void notify_(descriptor_type & desc);
+
+  ipc_ring_header * header_;
+  char * slots_;
+  // wakes up the reader, i.e. data became available.
+  descriptor_type readable_;
+  // wakes up the writer, i.e. space became available.
+  descriptor_type writable_;
+};
+
+}
+
+}
+
+#endif //BOOST_COBALT_DETAIL_IPC_CHANNEL_HPP
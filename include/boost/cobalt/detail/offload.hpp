@@ -0,0 +1,156 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_DETAIL_OFFLOAD_HPP
+#define BOOST_COBALT_DETAIL_OFFLOAD_HPP
+
+#include <boost/cobalt/config.hpp>
+#include <boost/cobalt/unique_handle.hpp>
+#include <boost/cobalt/detail/handler.hpp>
+
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/system/result.hpp>
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+namespace boost::cobalt
+{
+
+struct as_result_tag;
+
+// Passed to an offloaded function that takes it as its first parameter, so it can poll for cancellation.
+struct offload_token
+{
+  explicit offload_token(const std::atomic<bool> & flag) : flag_(&flag) {}
+  bool cancelled() const {return flag_->load(std::memory_order_relaxed);}
+ private:
+  const std::atomic<bool> * flag_;
+};
+
+namespace detail
+{
+
+// Work executed by the offload pool. It's part of the awaiter, so posting it doesn't allocate a result slot.
+struct offload_work
+{
+  void (*run)(offload_work * ) = nullptr;
+};
+
+BOOST_COBALT_DECL void post_offload(offload_work & work);
+
+template<bool TakesToken, typename Fn, typename ... Args>
+struct offload_result : std::invoke_result<Fn&, Args&...> {};
+
+template<typename Fn, typename ... Args>
+struct offload_result<true, Fn, Args...> : std::invoke_result<Fn&, offload_token, Args&...> {};
+
+template<typename Fn, typename ... Args>
+struct offload_op final : offload_work
+{
+  constexpr static bool takes_token = std::is_invocable_v<Fn&, offload_token, Args&...>;
+  using value_type = std::remove_cvref_t<typename offload_result<takes_token, Fn, Args...>::type>;
+
+  offload_op(Fn && fn, std::tuple<Args...> && args) : fn(std::move(fn)), args(std::move(args)) {}
+  // only valid before it's awaited
+  offload_op(offload_op && lhs) : fn(std::move(lhs.fn)), args(std::move(lhs.args)) {}
+
+  Fn fn;
+  std::tuple<Args...> args;
+  std::atomic<bool> cancelled{false};
+  std::optional<system::result<value_type, std::exception_ptr>> result;
+
+  executor exec;
+  unique_handle<void> awaited_from{nullptr};
+  asio::cancellation_slot cl;
+
+  struct cancel_impl
+  {
+    std::atomic<bool> * flag;
+    cancel_impl(std::atomic<bool> * flag) : flag(flag) {}
+    void operator()(asio::cancellation_type)
+    {
+      flag->store(true, std::memory_order_relaxed);
+    }
+  };
+
+  bool await_ready() const {return false;}
+
+  template<typename Promise>
+  void await_suspend(std::coroutine_handle<Promise> h)
+  {
+    exec = detail::get_executor(h);
+    if constexpr (requires {h.promise().get_cancellation_slot();})
+      if ((cl = h.promise().get_cancellation_slot()).is_connected())
+        cl.template emplace<cancel_impl>(&cancelled);
+
+    awaited_from.reset(h.address());
+    this->run = &run_;
+    post_offload(*this);
+  }
+
+  static value_type invoke_(offload_op & op)
+  {
+    return std::apply(
+        [&](Args & ... args) -> value_type
+        {
+          if constexpr (takes_token)
+            return std::invoke(op.fn, offload_token{op.cancelled}, args...);
+          else
+            return std::invoke(op.fn, args...);
+        }, op.args);
+  }
+
+  // runs on the pool & resumes the awaiting coroutine on its executor.
+  static void run_(offload_work * work)
+  {
+    auto & op = *static_cast<offload_op*>(work);
+    try
+    {
+      if constexpr (std::is_void_v<value_type>)
+      {
+        invoke_(op);
+        op.result.emplace(system::in_place_value);
+      }
+      else
+        op.result.emplace(system::in_place_value, invoke_(op));
+    }
+    catch (...)
+    {
+      op.result.emplace(system::in_place_error, std::current_exception());
+    }
+    asio::post(op.exec, std::move(op.awaited_from));
+  }
+
+  system::result<value_type, std::exception_ptr> await_resume(const as_result_tag &)
+  {
+    if (cl.is_connected())
+      cl.clear();
+    return std::move(*result);
+  }
+
+  value_type await_resume()
+  {
+    if (cl.is_connected())
+      cl.clear();
+    if constexpr (std::is_void_v<value_type>)
+      result->value();
+    else
+      return std::move(*result).value();
+  }
+};
+
+}
+
+}
+
+#endif //BOOST_COBALT_DETAIL_OFFLOAD_HPP
@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_DETAIL_PARALLEL_HPP
+#define BOOST_COBALT_DETAIL_PARALLEL_HPP
+
+#include <boost/cobalt/join.hpp>
+#include <boost/cobalt/promise.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace boost::cobalt::detail
+{
+
+// the output of parallel_for_each
+struct parallel_no_output {};
+
+template<typename Range, typename Fn, typename Output>
+struct parallel_state
+{
+  parallel_state(Range && range, Fn && fn, Output out)
+      : range(static_cast<Range&&>(range)), itr(std::begin(this->range)), fn(std::move(fn)), out(std::move(out)) {}
+
+  Range range;
+  decltype(std::begin(std::declval<Range&>())) itr;
+  Fn fn;
+  Output out;
+  std::size_t next = 0u;
+  std::exception_ptr error;
+  std::vector<promise<void>> workers;
+
+  // the first error cancels the other workers.
+  void fail(std::exception_ptr ep)
+  {
+    if (error)
+      return;
+    error = std::move(ep);
+    for (auto & w : workers)
+      w.cancel();
+  }
+};
+
+// The workers pull the next element from the range, so there's one frame per worker instead of one per element.
+template<typename State>
+promise<void> parallel_worker(State & st)
+{
+  while (!st.error && st.itr != std::end(st.range))
+  {
+    const auto idx = st.next++;
+    auto && elem = *st.itr;
+    ++st.itr;
+    try
+    {
+      if constexpr (std::is_same_v<decltype(st.out), parallel_no_output>)
+        co_await std::invoke(st.fn, elem);
+      else
+        st.out[static_cast<std::iter_difference_t<decltype(st.out)>>(idx)] = co_await std::invoke(st.fn, elem);
+    }
+    catch (...)
+    {
+      st.fail(std::current_exception());
+    }
+  }
+}
+
+template<typename Range, typename Fn, typename Output>
+promise<void> parallel_impl(Range range, Fn fn, Output out, std::size_t concurrency)
+{
+  parallel_state<Range, Fn, Output> st{static_cast<Range&&>(range), std::move(fn), std::move(out)};
+
+  const auto k = (std::max)(std::size_t(1u), concurrency);
+  // reserved, so that the workers don't get moved while a worker might cancel them.
+  st.workers.reserve(k);
+  for (std::size_t i = 0u; i < k && !st.error && st.itr != std::end(st.range); i++)
+    st.workers.push_back(parallel_worker(st));
+
+  // join forwards the cancellation to all workers.
+  if (!st.workers.empty())
+    co_await join(st.workers);
+  if (st.error)
+    std::rethrow_exception(st.error);
+}
+
+}
+
+#endif //BOOST_COBALT_DETAIL_PARALLEL_HPP
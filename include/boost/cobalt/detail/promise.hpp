@@ -86,6 +86,13 @@ struct promise_value_holder<void>
 
 
 
+// Gets invoked when a promise completes without being awaited, e.g. by a wait_group.
+struct promise_notification
+{
+  // returns the coroutine to resume.
+  std::coroutine_handle<void> (*completed)(promise_notification * ) = nullptr;
+};
+
 template<typename T>
 struct promise_receiver : promise_value_holder<T>
 {
@@ -109,6 +116,7 @@ struct promise_receiver : promise_value_holder<T>
 
   bool done = false;
   unique_handle<void>  awaited_from{nullptr};
+  promise_notification * notification = nullptr;
 
   void set_done()
   {
@@ -120,6 +128,7 @@ struct promise_receiver : promise_value_holder<T>
   promise_receiver(promise_receiver && lhs) noexcept
       : promise_value_holder<T>(std::move(lhs)),
         exception(std::move(lhs.exception)), done(lhs.done), awaited_from(std::move(lhs.awaited_from)),
+        notification(std::exchange(lhs.notification, nullptr)),
         reference(lhs.reference), cancel_signal(lhs.cancel_signal)
   {
     if (!done && !exception)
@@ -142,6 +151,7 @@ struct promise_receiver : promise_value_holder<T>
     exception = std::move(lhs.exception);
     done = std::move(lhs.done);
     awaited_from = std::move(lhs.awaited_from);
+    notification = std::exchange(lhs.notification, nullptr);
     reference = std::move(lhs.reference);
     cancel_signal = std::move(lhs.cancel_signal);
 
@@ -334,6 +344,8 @@ struct cobalt_promise
   using executor_type = executor;
   executor_type exec;
   const executor_type & get_executor() const {return exec;}
+  // used by switch_to
+  void set_executor(executor_type exec_) {exec = std::move(exec_);}
 
   template<typename ... Args>
   cobalt_promise(Args & ...args)
@@ -377,7 +389,8 @@ struct cobalt_promise
     cobalt_promise * promise;
     bool await_ready() const noexcept
     {
-      return promise->receiver && promise->receiver->awaited_from.get() == nullptr;
+      return promise->receiver && promise->receiver->awaited_from.get() == nullptr
+                               && promise->receiver->notification == nullptr;
     }
 
     std::coroutine_handle<void> await_suspend(std::coroutine_handle<cobalt_promise> h) noexcept
@@ -385,6 +398,8 @@ struct cobalt_promise
       std::coroutine_handle<void> res = std::noop_coroutine();
       if (promise->receiver && promise->receiver->awaited_from.get() != nullptr)
         res = promise->receiver->awaited_from.release();
+      else if (promise->receiver && promise->receiver->notification != nullptr)
+        res = promise->receiver->notification->completed(promise->receiver->notification);
 
 
       if (auto &rec = h.promise().receiver; rec != nullptr)
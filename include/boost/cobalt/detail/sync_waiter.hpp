@@ -0,0 +1,191 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_DETAIL_SYNC_WAITER_HPP
+#define BOOST_COBALT_DETAIL_SYNC_WAITER_HPP
+
+#include <boost/cobalt/config.hpp>
+#include <boost/cobalt/unique_handle.hpp>
+
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/intrusive/list.hpp>
+#include <boost/system/result.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <coroutine>
+#include <stdexcept>
+#include <utility>
+
+namespace boost::cobalt::detail
+{
+
+// A coroutine waiting for a synchronization primitive, e.g. a mutex.
+// The primitive gets handed over directly, i.e. a waiter that got resumed already owns it.
+struct sync_waiter : intrusive::list_base_hook<intrusive::link_mode<intrusive::auto_unlink> >
+{
+  executor * exec;
+  boost::source_location loc;
+  bool cancelled = false, direct = false;
+  // if a shared lock is requested from a shared_mutex.
+  bool shared = false;
+  // invoked when the waiter leaves the queue without getting the primitive.
+  void * owner = nullptr;
+  void (*on_cancel)(void * owner) = nullptr;
+
+  asio::cancellation_slot cancel_slot{};
+  unique_handle<void> awaited_from{nullptr};
+  void (*begin_transaction)(void*) = nullptr;
+  // the next waiter of a batch, see complete_all.
+  sync_waiter * next_in_batch = nullptr;
+
+  sync_waiter(executor & exec, const boost::source_location & loc) : exec(&exec), loc(loc) {}
+
+  void transactional_unlink()
+  {
+    if (begin_transaction)
+      begin_transaction(awaited_from.get());
+    this->unlink();
+  }
+
+  void interrupt_await()
+  {
+    if (!direct)
+    {
+      cancelled = true;
+      // interrupted before it got queued, e.g. by a race whose other awaitable was ready.
+      const bool queued = this->is_linked();
+      this->unlink();
+      if (queued && on_cancel)
+        on_cancel(owner);
+      if (awaited_from)
+        awaited_from.release().resume();
+    }
+  }
+
+  struct cancel_impl
+  {
+    sync_waiter * op;
+    cancel_impl(sync_waiter * op) : op(op) {}
+    void operator()(asio::cancellation_type)
+    {
+      op->cancelled = true;
+      const bool queued = op->is_linked();
+      op->unlink();
+      if (queued && op->on_cancel)
+        op->on_cancel(op->owner);
+      if (op->awaited_from)
+        asio::post(*op->exec, std::move(op->awaited_from));
+      op->cancel_slot.clear();
+    }
+  };
+
+  // Hand over the primitive & resume the waiter.
+  void complete()
+  {
+    direct = true;
+    cancel_slot.clear();
+    transactional_unlink();
+    BOOST_ASSERT(awaited_from);
+    asio::post(*exec, std::move(awaited_from));
+  }
+
+  template<typename Promise, typename Queue>
+  void enqueue(std::coroutine_handle<Promise> h, Queue & queue)
+  {
+    if constexpr (requires {h.promise().get_cancellation_slot();})
+      if ((cancel_slot = h.promise().get_cancellation_slot()).is_connected())
+        cancel_slot.emplace<cancel_impl>(this);
+
+    if (awaited_from)
+      boost::throw_exception(std::runtime_error("already-awaited"), loc);
+    awaited_from.reset(h.address());
+
+    if constexpr (requires {h.promise().begin_transaction();})
+      begin_transaction = +[](void * p){std::coroutine_handle<Promise>::from_address(p).promise().begin_transaction();};
+
+    queue.push_back(*this);
+  }
+
+  system::result<void> result()
+  {
+    if (cancel_slot.is_connected())
+      cancel_slot.clear();
+
+    if (cancelled)
+    {
+      constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION};
+      return {system::in_place_error, asio::error::operation_aborted, &loc};
+    }
+    return system::in_place_value;
+  }
+};
+
+using sync_waiter_queue = intrusive::list<sync_waiter, intrusive::constant_time_size<false> >;
+
+// Waiters are destroyed with the primitive, like with a channel.
+inline void destroy_waiters(sync_waiter_queue & queue)
+{
+  while (!queue.empty())
+  {
+    auto & w = queue.front();
+    w.unlink();
+    w.awaited_from.reset();
+  }
+}
+
+// Resumes a batch of waiters from a single handler.
+struct resume_batch
+{
+  sync_waiter * head;
+
+  explicit resume_batch(sync_waiter * head) : head(head) {}
+  resume_batch(resume_batch && lhs) noexcept : head(std::exchange(lhs.head, nullptr)) {}
+
+  void operator()()
+  {
+    while (head)
+    {
+      // the waiter lives in the frame that's getting resumed.
+      auto & w = *std::exchange(head, head->next_in_batch);
+      w.awaited_from.release().resume();
+    }
+  }
+
+  // the handler got destroyed without being invoked, e.g. by shutting down the context.
+  ~resume_batch()
+  {
+    while (head)
+      std::exchange(head, head->next_in_batch)->awaited_from.reset();
+  }
+};
+
+// Hand over the primitive to all waiters & resume them with one post.
+inline void complete_all(sync_waiter_queue & queue, executor & exec)
+{
+  sync_waiter * head = nullptr;
+  sync_waiter ** tail = &head;
+  while (!queue.empty())
+  {
+    auto & w = queue.front();
+    w.direct = true;
+    w.cancel_slot.clear();
+    w.transactional_unlink();
+    BOOST_ASSERT(w.awaited_from);
+    w.next_in_batch = nullptr;
+    *tail = &w;
+    tail = &w.next_in_batch;
+  }
+
+  if (head)
+    asio::post(exec, resume_batch{head});
+}
+
+}
+
+#endif //BOOST_COBALT_DETAIL_SYNC_WAITER_HPP
@@ -317,6 +317,12 @@ struct task_promise
       BOOST_ASSERT(exec_);
       return *exec_;
   }
+  // used by switch_to
+  void set_executor(executor_type exec_new)
+  {
+    exec.emplace(exec_new);
+    exec_ = exec->get_executor();
+  }
 
   template<typename ... Args>
   task_promise(Args & ...args)
@@ -17,7 +17,11 @@
 
 #include <boost/asio/cancellation_signal.hpp>
 
+#include <atomic>
+#include <optional>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace boost::cobalt
 {
@@ -25,6 +29,26 @@ namespace boost::cobalt
 struct as_tuple_tag;
 struct as_result_tag;
 
+// tag::outline[]
+// Options applied to a thread when it starts, by passing them as the first parameter of the thread function.
+// They are applied on a best-effort basis, e.g. setting a realtime policy without privileges is ignored.
+struct thread_options
+{
+  // The name shown by tools like top or perf. Linux truncates it to 15 characters.
+  std::string name;
+  // The cores to pin the thread to. Only supported on linux.
+  std::vector<unsigned> cpus;
+  // If non-zero, use SCHED_FIFO with this priority.
+  int fifo_priority = 0;
+  // The nice level of the thread. Only supported on linux.
+  std::optional<int> nice;
+  // The amount of stack to touch before running, so the first calls don't page fault.
+  std::size_t prefault_stack = 0u;
+  // The concurrency hint of the thread's io_context.
+  int concurrency_hint = 1;
+};
+// end::outline[]
+
 namespace detail
 {
 struct thread_promise;
@@ -42,13 +66,29 @@ struct signal_helper_2
 };
 
 
+// Apply the options to the calling thread.
+BOOST_COBALT_DECL void apply_thread_options(const thread_options & opts);
+
 struct thread_state
 {
-  asio::io_context ctx{1u};
+  explicit thread_state(int concurrency_hint = 1) : ctx{concurrency_hint} {}
+
+  asio::io_context ctx;
   asio::cancellation_signal signal;
-  std::mutex mtx;
+
+  // set once the coroutine suspended initially, so the thread can resume it.
+  std::atomic<bool> suspended{false};
+
+  // running -> registering -> waiting is done by the awaiter, which emplaces the waitor in between,
+  // running | waiting -> finished by the thread, which owns the waitor afterwards.
+  // The thread waits for a registering awaiter, so the waitor never gets dropped with the awaiting frame.
+  enum status_t : unsigned char {running, registering, waiting, finished};
+  std::atomic<status_t> status{running};
   std::optional<completion_handler<std::exception_ptr>> waitor;
-  std::atomic<bool> done = false;
+  // the exception of the thread, published before it's finished.
+  std::exception_ptr ep;
+
+  bool done() const {return status.load(std::memory_order_acquire) == finished;}
 };
 
 struct thread_promise : signal_helper_2,
@@ -60,13 +100,22 @@ struct thread_promise : signal_helper_2,
                         enable_await_deferred
 {
   BOOST_COBALT_DECL thread_promise();
+  // the options must be the first parameter of the thread function.
+  template<typename ... Args>
+  thread_promise(const thread_options & opts, Args && ...) : thread_promise()
+  {
+    options_ = opts;
+  }
 
   struct initial_awaitable
   {
     bool await_ready() const {return false;}
     void await_suspend(std::coroutine_handle<thread_promise> h)
     {
-      h.promise().mtx.unlock();
+      // the state is kept alive by the thread object, which hasn't been returned yet.
+      auto & st = *h.promise().state_;
+      st.suspended.store(true, std::memory_order_release);
+      st.suspended.notify_one();
     }
 
     void await_resume() {}
@@ -114,11 +163,12 @@ struct thread_promise : signal_helper_2,
     exec_.emplace(exec);
   }
 
-  std::mutex mtx;
  private:
 
   std::optional<asio::executor_work_guard<asio::io_context::executor_type>> wexec_;
   std::optional<cobalt::executor> exec_;
+  thread_options options_;
+  thread_state * state_ = nullptr;
 };
 
 struct thread_awaitable
@@ -129,8 +179,7 @@ struct thread_awaitable
   {
     if (state_ == nullptr)
       boost::throw_exception(std::invalid_argument("Thread expired"), loc);
-    std::lock_guard<std::mutex> lock{state_->mtx};
-    return state_->done;
+    return state_->done();
   }
 
   template<typename Promise>
@@ -138,9 +187,10 @@ struct thread_awaitable
   {
     BOOST_ASSERT(state_);
 
-    std::lock_guard<std::mutex> lock{state_->mtx};
-    if (state_->done)
-      return false;
+    auto expected = thread_state::running;
+    if (!state_->status.compare_exchange_strong(expected, thread_state::registering,
+                                                std::memory_order_acquire, std::memory_order_acquire))
+      return false; // finished in the meantime, await_resume takes the exception from the state.
 
     if constexpr (requires {h.promise().get_cancellation_slot();})
       if ((cl = h.promise().get_cancellation_slot()).is_connected())
@@ -148,7 +198,6 @@ struct thread_awaitable
         cl.assign(
             [st = state_](asio::cancellation_type type)
             {
-              std::lock_guard<std::mutex> lock{st->mtx};
               asio::post(st->ctx,
                          [st, type]
                          {
@@ -159,7 +208,22 @@ struct thread_awaitable
 
       }
 
-    state_->waitor.emplace(h, res);
+    BOOST_TRY
+    {
+      state_->waitor.emplace(h, res);
+    }
+    BOOST_CATCH(...)
+    {
+      if (cl.is_connected())
+        cl.clear();
+      state_->status.store(thread_state::running, std::memory_order_release);
+      state_->status.notify_one();
+      BOOST_RETHROW
+    }
+    BOOST_CATCH_END
+
+    state_->status.store(thread_state::waiting, std::memory_order_release);
+    state_->status.notify_one();
     return true;
   }
 
@@ -170,7 +234,7 @@ struct thread_awaitable
     if (thread_)
       thread_->join();
     if (!res) // await_ready
-      return;
+      res.emplace(state_->ep);
     if (auto ee = std::get<0>(*res))
       std::rethrow_exception(ee);
   }
@@ -182,7 +246,7 @@ struct thread_awaitable
     if (thread_)
       thread_->join();
     if (!res) // await_ready
-      return {system::in_place_value};
+      res.emplace(state_->ep);
     if (auto ee = std::get<0>(*res))
       return {system::in_place_error, std::move(ee)};
 
@@ -195,6 +259,8 @@ struct thread_awaitable
       cl.clear();
     if (thread_)
       thread_->join();
+    if (!res) // await_ready
+      res.emplace(state_->ep);
 
     return std::get<0>(*res);
   }
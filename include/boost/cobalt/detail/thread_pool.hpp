@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_DETAIL_THREAD_POOL_HPP
+#define BOOST_COBALT_DETAIL_THREAD_POOL_HPP
+
+#include <boost/cobalt/op.hpp>
+#include <boost/cobalt/spawn.hpp>
+#include <boost/cobalt/task.hpp>
+
+#include <boost/asio/append.hpp>
+#include <boost/asio/bind_allocator.hpp>
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/post.hpp>
+
+#include <exception>
+#include <memory>
+#include <optional>
+#include <tuple>
+
+namespace boost::cobalt::detail
+{
+
+template<typename T>
+struct thread_pool_task;
+
+template<typename T>
+struct thread_pool_task<task<T>>
+{
+  using value_type = T;
+  using op_type = op<std::exception_ptr, T>;
+  using handler_type = completion_handler<std::exception_ptr, T>;
+};
+
+template<>
+struct thread_pool_task<task<void>>
+{
+  using value_type = void;
+  using op_type = op<std::exception_ptr>;
+  using handler_type = completion_handler<std::exception_ptr>;
+};
+
+// the cancellation of a job, which lives on the worker thread.
+struct thread_pool_job
+{
+  asio::cancellation_signal signal;
+};
+
+template<typename Fn, typename ... Args>
+struct thread_pool_op final : thread_pool_task<std::invoke_result_t<Fn, Args...>>::op_type
+{
+  using task_type = std::invoke_result_t<Fn, Args...>;
+  using handler_type = typename thread_pool_task<task_type>::handler_type;
+
+  thread_pool_op(executor exec, Fn fn, Args ... args)
+      : exec_(std::move(exec)), fn_(std::move(fn)), args_(std::move(args)...)
+  {
+  }
+
+  void initiate(handler_type h) final
+  {
+    auto job = std::make_shared<thread_pool_job>();
+    auto slot = h.get_cancellation_slot();
+
+    // the task gets created on the worker, so its frame comes from the worker's memory resource.
+    asio::post(
+        exec_,
+        [this, job, h = std::move(h)]() mutable
+        {
+          // the handler's allocator belongs to the awaiting thread, so it must not be used here.
+          std::optional<task_type> t;
+#if !defined(BOOST_NO_EXCEPTIONS)
+          try
+          {
+#endif
+            t.emplace(std::apply(std::move(fn_), std::move(args_)));
+#if !defined(BOOST_NO_EXCEPTIONS)
+          }
+          catch (...)
+          {
+            if constexpr (std::is_void_v<typename thread_pool_task<task_type>::value_type>)
+              asio::post(asio::bind_allocator(std::allocator<void>(),
+                                              asio::append(std::move(h), std::current_exception())));
+            else
+              asio::post(asio::bind_allocator(std::allocator<void>(),
+                                              asio::append(std::move(h), std::current_exception(),
+                                                           typename thread_pool_task<task_type>::value_type{})));
+            return;
+          }
+#endif
+          cobalt::spawn(exec_, std::move(*t),
+                        asio::bind_allocator(std::allocator<void>(),
+                                             asio::bind_cancellation_slot(job->signal.slot(), std::move(h))));
+        });
+
+    // posted after the job, so a cancellation can't overtake it.
+    if (slot.is_connected())
+      slot.assign(
+          [exec = exec_, job](asio::cancellation_type ct)
+          {
+            asio::post(exec, [job, ct] {job->signal.emit(ct);});
+          });
+  }
+
+ private:
+  executor exec_;
+  Fn fn_;
+  std::tuple<Args...> args_;
+};
+
+}
+
+#endif //BOOST_COBALT_DETAIL_THREAD_POOL_HPP
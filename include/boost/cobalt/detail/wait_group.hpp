@@ -9,118 +9,34 @@
 #define BOOST_COBALT_DETAIL_WAIT_GROUP_HPP
 
 #include <boost/cobalt/promise.hpp>
-#include <boost/cobalt/race.hpp>
-#include <boost/cobalt/gather.hpp>
 
-#include <list>
+#include <boost/intrusive/list.hpp>
 
+#include <memory>
+#include <optional>
+#include <vector>
 
-namespace boost::cobalt::detail
-{
 
-struct race_wrapper
+namespace boost::cobalt
 {
-  using impl_type = decltype(race(std::declval<std::list<promise<void>> &>()));
-  std::list<promise<void>> &waitables_;
-
-  race_wrapper(std::list<promise<void>> &waitables) : waitables_(waitables)
-  {
-  }
-
-  struct awaitable_type
-  {
-
-    bool await_ready()
-    {
-      if (waitables_.empty())
-        return true;
-      else
-        return impl_->await_ready();
-    }
-
-    template<typename Promise>
-    auto await_suspend(std::coroutine_handle<Promise> h)
-    {
-      return impl_->await_suspend(h);
-    }
 
-    void await_resume()
-    {
-      if (waitables_.empty())
-        return;
-      auto idx = impl_->await_resume();
-      if (idx != std::numeric_limits<std::size_t>::max())
-        waitables_.erase(std::next(waitables_.begin(), idx));
-    }
-
-    awaitable_type(std::list<promise<void>> &waitables) : waitables_(waitables)
-    {
-        if (!waitables_.empty())
-          impl_.emplace(waitables_, random_);
-    }
-
-   private:
-    std::optional<impl_type::awaitable> impl_;
-    std::list<promise<void>> &waitables_;
-    std::default_random_engine &random_{detail::prng()};
-
-  };
-  awaitable_type operator co_await() &&
-  {
-    return awaitable_type(waitables_);
-  }
-};
+struct wait_group;
 
-struct gather_wrapper
+namespace detail
 {
-  using impl_type = decltype(gather(std::declval<std::list<promise<void>> &>()));
-  std::list<promise<void>> &waitables_;
 
-  gather_wrapper(std::list<promise<void>> &waitables) : waitables_(waitables)
-  {
-  }
-
-  struct awaitable_type
-  {
-    bool await_ready()
-    {
-      if (waitables_.empty())
-        return true;
-      else
-        return impl_->await_ready();
-    }
-
-    template<typename Promise>
-    auto await_suspend(std::coroutine_handle<Promise> h)
-    {
-      return impl_->await_suspend(h);
-    }
-
-    void await_resume()
-    {
-      if (waitables_.empty())
-        return;
-      BOOST_ASSERT(impl_);
-      impl_->await_resume();
-      waitables_.clear();
-    }
-
-    awaitable_type(std::list<promise<void>> &waitables) : waitables_(waitables)
-    {
-      if (!waitables_.empty())
-        impl_.emplace(waitables_);
-    }
-   private:
-    std::list<promise<void>> &waitables_;
-    std::optional<decltype(gather(waitables_).operator co_await())> impl_;
-  };
+// A promise held by a wait_group. The nodes get allocated in slabs and reused,
+// and a node moves to the ready list when its promise completes.
+struct wait_group_node : promise_notification, intrusive::list_base_hook<>
+{
+  wait_group * group = nullptr;
+  std::optional<promise<void>> promise_;
+};
 
-  awaitable_type operator co_await()
-  {
-    return awaitable_type(waitables_);
-  }
+using wait_group_list = intrusive::list<wait_group_node, intrusive::constant_time_size<true> >;
+using wait_group_slab = std::unique_ptr<wait_group_node[]>;
 
-};
+}
 
 }
 
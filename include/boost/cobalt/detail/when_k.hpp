@@ -0,0 +1,536 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_DETAIL_WHEN_K_HPP
+#define BOOST_COBALT_DETAIL_WHEN_K_HPP
+
+#include <boost/cobalt/detail/await_result_helper.hpp>
+#include <boost/cobalt/detail/exception.hpp>
+#include <boost/cobalt/detail/fork.hpp>
+#include <boost/cobalt/detail/forward_cancellation.hpp>
+#include <boost/cobalt/detail/util.hpp>
+#include <boost/cobalt/detail/wrapper.hpp>
+#include <boost/cobalt/this_thread.hpp>
+
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/system/result.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <array>
+#include <coroutine>
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+namespace boost::cobalt::detail
+{
+
+// k is larger than the amount of awaitables.
+inline std::exception_ptr when_k_invalid_quorum()
+{
+  return std::make_exception_ptr(system::system_error(asio::error::invalid_argument, "when_k"));
+}
+
+template<typename ... Args>
+struct when_k_variadic_impl
+{
+  using tuple_type = std::tuple<decltype(get_awaitable_type(std::declval<Args&&>()))...>;
+
+  BOOST_COBALT_MSVC_NOINLINE
+  when_k_variadic_impl(std::size_t k, Args && ... args)
+      : k(k), args{std::forward<Args>(args)...}
+  {
+  }
+
+  std::size_t k;
+  std::tuple<Args...> args;
+
+  constexpr static std::size_t tuple_size = sizeof...(Args);
+
+  struct awaitable : fork::static_shared_state<256 * tuple_size>
+  {
+    template<std::size_t ... Idx>
+    awaitable(std::size_t k, std::tuple<Args...> & args, std::index_sequence<Idx...>) :
+        k(k), aws(awaitable_type_getter<Args>(std::get<Idx>(args))...)
+    {
+    }
+
+    std::size_t k;
+    tuple_type aws;
+
+    std::array<asio::cancellation_signal, tuple_size> cancel_;
+    template<typename > constexpr static auto make_null() {return nullptr;};
+    std::array<asio::cancellation_signal*, tuple_size> cancel = {make_null<Args>()...};
+
+    template<typename T>
+    using result_store_part =
+        std::optional<void_as_monostate<co_await_result_t<T>>>;
+
+    std::tuple<result_store_part<Args>...> result;
+    std::size_t succeeded = 0u, failed = 0u;
+    std::exception_ptr error;
+
+    // the quorum has been reached or cannot be reached anymore.
+    bool decided() const {return succeeded >= k || tuple_size - failed < k;}
+
+    // like race: interrupt first, which only applies to the ones that are still awaited, i.e. have a cancel entry.
+    void cancel_all()
+    {
+      interrupt_await();
+      for (auto & r : cancel)
+        if (r)
+          std::exchange(r, nullptr)->emit(asio::cancellation_type::all);
+    }
+
+    template<std::size_t Idx>
+    void interrupt_await_step()
+    {
+      using type = std::tuple_element_t<Idx, tuple_type>;
+      using t = std::conditional_t<std::is_reference_v<std::tuple_element_t<Idx, std::tuple<Args...>>>,
+          type &,
+          type &&>;
+
+      if constexpr (interruptible<t>)
+        if (this->cancel[Idx] != nullptr)
+          static_cast<t>(std::get<Idx>(aws)).interrupt_await();
+    }
+
+    void interrupt_await()
+    {
+      mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Args)>>
+          ([&](auto idx)
+           {
+             interrupt_await_step<idx>();
+           });
+    }
+
+    template<std::size_t Idx, typename ... Value>
+    void succeed(Value && ... value)
+    {
+      cancel[Idx] = nullptr;
+      if (succeeded >= k) // completed after the quorum was reached
+        return;
+      std::get<Idx>(result).emplace(std::forward<Value>(value)...);
+      if (++succeeded == k)
+        cancel_all();
+    }
+
+    void fail(std::size_t idx, std::exception_ptr ep)
+    {
+      cancel[idx] = nullptr;
+      failed++;
+      if (!error)
+        error = std::move(ep);
+      if (decided())
+        cancel_all();
+    }
+
+    // GCC doesn't like member funs
+    template<std::size_t Idx>
+    static detail::fork await_impl(awaitable & this_)
+    BOOST_TRY
+    {
+      auto & aw = std::get<Idx>(this_.aws);
+      // check manually if we're ready
+      auto rd = aw.await_ready();
+      if (!rd)
+      {
+        this_.cancel[Idx] = &this_.cancel_[Idx];
+        co_await this_.cancel[Idx]->slot();
+        // make sure the executor is set
+        co_await detail::fork::wired_up;
+        // do the await - this doesn't call await-ready again
+
+        if constexpr (std::is_void_v<decltype(aw.await_resume())>)
+        {
+          co_await aw;
+          this_.template succeed<Idx>();
+        }
+        else
+          this_.template succeed<Idx>(co_await aw);
+      }
+      else
+      {
+        if constexpr (std::is_void_v<decltype(aw.await_resume())>)
+        {
+          aw.await_resume();
+          this_.template succeed<Idx>();
+        }
+        else
+          this_.template succeed<Idx>(aw.await_resume());
+      }
+    }
+    BOOST_CATCH(...)
+    {
+      this_.fail(Idx, std::current_exception());
+    }
+    BOOST_CATCH_END
+
+    std::array<detail::fork(*)(awaitable&), tuple_size> impls {
+        []<std::size_t ... Idx>(std::index_sequence<Idx...>)
+        {
+          return std::array<detail::fork(*)(awaitable&), tuple_size>{&await_impl<Idx>...};
+        }(std::make_index_sequence<tuple_size>{})
+    };
+
+    detail::fork last_forked;
+    std::size_t last_index = 0u;
+
+    bool await_ready()
+    {
+      if (k == 0u || k > tuple_size)
+        return true;
+
+      while (last_index < tuple_size)
+      {
+        last_forked = impls[last_index++](*this);
+        if (!last_forked.done())
+          return false; // one coro didn't immediately complete!
+      }
+      last_forked.release();
+      return true;
+    }
+
+    template<typename H>
+    auto await_suspend(
+          std::coroutine_handle<H> h
+#if defined(BOOST_ASIO_ENABLE_HANDLER_TRACKING)
+        , const boost::source_location & loc = BOOST_CURRENT_LOCATION
+#endif
+    )
+    {
+#if defined(BOOST_ASIO_ENABLE_HANDLER_TRACKING)
+      this->loc = loc;
+#endif
+      this->exec = detail::get_executor(h);
+      last_forked.release().resume();
+      while (last_index < tuple_size)
+        impls[last_index++](*this).release();
+
+      if (decided())
+        cancel_all();
+
+      if (!this->outstanding_work()) // already done, resume rightaway.
+        return false;
+
+      // arm the cancel
+      assign_cancellation(
+          h,
+          [&](asio::cancellation_type ct)
+          {
+            for (auto cs : cancel)
+              if (cs)
+                cs->emit(ct);
+          });
+
+      this->coro.reset(h.address());
+      return true;
+    }
+
+    std::exception_ptr get_error() const
+    {
+      if (succeeded >= k)
+        return nullptr;
+      return error ? error : when_k_invalid_quorum();
+    }
+
+    BOOST_COBALT_MSVC_NOINLINE
+    auto await_resume()
+    {
+      if (auto ep = get_error())
+        std::rethrow_exception(ep);
+      return std::move(result);
+    }
+
+    auto await_resume(const as_tuple_tag &)
+    {
+      if (auto ep = get_error())
+        return std::make_tuple(ep, decltype(result){});
+      return std::make_tuple(std::exception_ptr(), std::move(result));
+    }
+
+    auto await_resume(const as_result_tag &)
+    {
+      using rt = system::result<decltype(result), std::exception_ptr>;
+      if (auto ep = get_error())
+        return rt(system::in_place_error, ep);
+      return rt(system::in_place_value, std::move(result));
+    }
+  };
+
+  awaitable operator co_await() &&
+  {
+    return awaitable(k, args, std::make_index_sequence<sizeof...(Args)>{});
+  }
+};
+
+template<typename Range>
+struct when_k_ranged_impl
+{
+  std::size_t k;
+  Range aws;
+
+  using result_type = co_await_result_t<std::decay_t<decltype(*std::begin(std::declval<Range>()))>>;
+  // the index of every successful awaitable, paired with its result.
+  using value_type = std::conditional_t<std::is_void_v<result_type>,
+                                        std::size_t,
+                                        std::pair<std::size_t, result_type>>;
+
+  constexpr static std::size_t result_size =
+      sizeof(std::conditional_t<std::is_void_v<result_type>, variant2::monostate, result_type>);
+
+  struct awaitable : fork::shared_state
+  {
+    using type = std::decay_t<decltype(*std::begin(std::declval<Range>()))>;
+#if !defined(BOOST_COBALT_NO_PMR)
+    pmr::polymorphic_allocator<void> alloc{&resource};
+
+    std::conditional_t<awaitable_type<type>, Range &,
+                       pmr::vector<co_awaitable_type<type>>> aws;
+
+    pmr::vector<asio::cancellation_signal> cancel_{std::size(aws), alloc};
+    pmr::vector<asio::cancellation_signal*> cancel{std::size(aws), alloc};
+    pmr::vector<std::optional<void_as_monostate<result_type>>> result{cancel.size(), alloc};
+    // the indices of the results in the order they completed.
+    pmr::vector<std::size_t> order{alloc};
+#else
+    std::allocator<void> alloc;
+    std::conditional_t<awaitable_type<type>, Range &,  std::vector<co_awaitable_type<type>>> aws;
+
+    std::vector<asio::cancellation_signal> cancel_{std::size(aws), alloc};
+    std::vector<asio::cancellation_signal*> cancel{std::size(aws), alloc};
+    std::vector<std::optional<void_as_monostate<result_type>>> result{cancel.size(), alloc};
+    std::vector<std::size_t> order{alloc};
+#endif
+    std::size_t k;
+    std::size_t failed = 0u;
+    std::exception_ptr error{};
+
+    awaitable(std::size_t k, Range & aws_, std::false_type /* needs  operator co_await */)
+      :  fork::shared_state((512 + sizeof(co_awaitable_type<type>) + result_size) * std::size(aws_))
+      , aws{alloc}
+      , cancel_{std::size(aws_), alloc}
+      , cancel{std::size(aws_), alloc}
+      , result{std::size(aws_), alloc}
+      , k(k)
+    {
+      aws.reserve(std::size(aws_));
+      for (auto && a : aws_)
+      {
+        using a_0 = std::decay_t<decltype(a)>;
+        using a_t = std::conditional_t<
+            std::is_lvalue_reference_v<Range>, a_0 &, a_0 &&>;
+        aws.emplace_back(awaitable_type_getter<a_t>(static_cast<a_t>(a)));
+      }
+      order.reserve((std::min)(k, cancel.size()));
+    }
+    awaitable(std::size_t k, Range & aws, std::true_type /* needs operator co_await */)
+        : fork::shared_state((512 + sizeof(co_awaitable_type<type>) + result_size) * std::size(aws))
+        , aws(aws)
+        , k(k)
+    {
+      order.reserve((std::min)(k, cancel.size()));
+    }
+
+    awaitable(std::size_t k, Range & aws)
+      : awaitable(k, aws, std::bool_constant<awaitable_type<type>>{})
+    {
+    }
+
+    // the quorum has been reached or cannot be reached anymore.
+    bool decided() const {return order.size() >= k || cancel.size() - failed < k;}
+
+    // like race: interrupt first, which only applies to the ones that are still awaited, i.e. have a cancel entry.
+    void cancel_all()
+    {
+      interrupt_await();
+      for (auto & r : cancel)
+        if (r)
+          std::exchange(r, nullptr)->emit(asio::cancellation_type::all);
+    }
+
+    void interrupt_await()
+    {
+      using t = std::conditional_t<std::is_reference_v<Range>,
+          co_awaitable_type<type> &,
+          co_awaitable_type<type> &&>;
+
+      if constexpr (interruptible<t>)
+      {
+        std::size_t idx = 0u;
+        for (auto & aw : aws)
+          if (cancel[idx++])
+            static_cast<t>(aw).interrupt_await();
+      }
+    }
+
+    template<typename ... Value>
+    void succeed(std::size_t idx, Value && ... value)
+    {
+      cancel[idx] = nullptr;
+      if (order.size() >= k) // completed after the quorum was reached
+        return;
+      result[idx].emplace(std::forward<Value>(value)...);
+      order.push_back(idx);
+      if (order.size() == k)
+        cancel_all();
+    }
+
+    void fail(std::size_t idx, std::exception_ptr ep)
+    {
+      cancel[idx] = nullptr;
+      failed++;
+      if (!error)
+        error = std::move(ep);
+      if (decided())
+        cancel_all();
+    }
+
+    static detail::fork await_impl(awaitable & this_, std::size_t idx)
+    BOOST_TRY
+    {
+      auto & aw = *std::next(std::begin(this_.aws), idx);
+      auto rd = aw.await_ready();
+      if (!rd)
+      {
+        this_.cancel[idx] = &this_.cancel_[idx];
+        co_await this_.cancel[idx]->slot();
+        co_await detail::fork::wired_up;
+        if constexpr (std::is_void_v<decltype(aw.await_resume())>)
+        {
+          co_await aw;
+          this_.succeed(idx);
+        }
+        else
+          this_.succeed(idx, co_await aw);
+      }
+      else
+      {
+        if constexpr (std::is_void_v<decltype(aw.await_resume())>)
+        {
+          aw.await_resume();
+          this_.succeed(idx);
+        }
+        else
+          this_.succeed(idx, aw.await_resume());
+      }
+    }
+    BOOST_CATCH(...)
+    {
+      this_.fail(idx, std::current_exception());
+    }
+    BOOST_CATCH_END
+
+    detail::fork last_forked;
+    std::size_t last_index = 0u;
+
+    bool await_ready()
+    {
+      if (k == 0u || k > cancel.size())
+        return true;
+
+      while (last_index < cancel.size())
+      {
+        last_forked = await_impl(*this, last_index++);
+        if (!last_forked.done())
+          return false; // one coro didn't immediately complete!
+      }
+      last_forked.release();
+      return true;
+    }
+
+    template<typename H>
+    auto await_suspend(
+        std::coroutine_handle<H> h
+#if defined(BOOST_ASIO_ENABLE_HANDLER_TRACKING)
+        , const boost::source_location & loc = BOOST_CURRENT_LOCATION
+#endif
+    )
+    {
+#if defined(BOOST_ASIO_ENABLE_HANDLER_TRACKING)
+      this->loc = loc;
+#endif
+      exec = detail::get_executor(h);
+
+      last_forked.release().resume();
+      while (last_index < cancel.size())
+        await_impl(*this, last_index++).release();
+
+      if (decided())
+        cancel_all();
+
+      if (!this->outstanding_work()) // already done, resume right away.
+        return false;
+
+      // arm the cancel
+      assign_cancellation(
+          h,
+          [&](asio::cancellation_type ct)
+          {
+            for (auto cs : cancel)
+              if (cs)
+                cs->emit(ct);
+          });
+
+      this->coro.reset(h.address());
+      return true;
+    }
+
+    std::exception_ptr get_error() const
+    {
+      if (order.size() >= k)
+        return nullptr;
+      return error ? error : when_k_invalid_quorum();
+    }
+
+    auto make_result()
+    {
+#if defined(BOOST_COBALT_NO_PMR)
+      std::vector<value_type> rr;
+#else
+      pmr::vector<value_type> rr{this_thread::get_allocator()};
+#endif
+      rr.reserve(order.size());
+      for (auto idx : order)
+        if constexpr (std::is_void_v<result_type>)
+          rr.push_back(idx);
+        else
+          rr.emplace_back(idx, *std::move(result[idx]));
+      return rr;
+    }
+
+    auto await_resume(const as_tuple_tag & )
+    {
+      if (auto ep = get_error())
+        return std::make_tuple(ep, decltype(make_result()){});
+      return std::make_tuple(std::exception_ptr(), make_result());
+    }
+
+    auto await_resume(const as_result_tag & )
+    {
+      using rt = system::result<decltype(make_result()), std::exception_ptr>;
+      if (auto ep = get_error())
+        return rt(system::in_place_error, ep);
+      return rt(system::in_place_value, make_result());
+    }
+
+    BOOST_COBALT_MSVC_NOINLINE
+    auto await_resume()
+    {
+      if (auto ep = get_error())
+        std::rethrow_exception(ep);
+      return make_result();
+    }
+  };
+  awaitable operator co_await() && {return awaitable{k, aws};}
+};
+
+}
+
+#endif //BOOST_COBALT_DETAIL_WHEN_K_HPP
@@ -0,0 +1,237 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_DETAIL_WITH_TIMEOUT_HPP
+#define BOOST_COBALT_DETAIL_WITH_TIMEOUT_HPP
+
+#include <boost/cobalt/config.hpp>
+#include <boost/cobalt/detail/await_result_helper.hpp>
+#include <boost/cobalt/detail/handler.hpp>
+#include <boost/cobalt/detail/util.hpp>
+#include <boost/cobalt/this_thread.hpp>
+#if defined(BOOST_COBALT_NO_PMR)
+#include <boost/cobalt/detail/monotonic_resource.hpp>
+#endif
+
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/system/result.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <array>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+
+namespace boost::cobalt::detail
+{
+
+struct deadline_service;
+
+// A deadline registered with the timer shared by all with_timeout ops of an execution context.
+struct deadline_node
+{
+  std::chrono::steady_clock::time_point expiry;
+  asio::cancellation_signal signal;
+  bool expired = false;
+
+  deadline_node * prev = nullptr;
+  deadline_node * next = nullptr;
+  deadline_service * service = nullptr;
+};
+
+BOOST_COBALT_DECL void add_deadline(const executor & exec, deadline_node & node);
+BOOST_COBALT_DECL void remove_deadline(deadline_node & node);
+
+// The memory of the frame below, kept in the with_timeout op like a fork::static_shared_state.
+struct with_timeout_storage : private std::array<char, 256>
+{
+#if !defined(BOOST_COBALT_NO_PMR)
+  pmr::monotonic_buffer_resource resource{std::array<char, 256>::data(), std::array<char, 256>::size(),
+                                          this_thread::get_default_resource()};
+#else
+  detail::monotonic_resource resource{std::array<char, 256>::data(), std::array<char, 256>::size()};
+#endif
+};
+
+// The frame the awaited op gets suspended in, so it gets the deadline's cancellation slot
+// while the cancellation state of the awaiting coroutine stays as it is.
+struct with_timeout_promise
+{
+  asio::cancellation_slot slot;
+  executor exec;
+  std::coroutine_handle<void> awaited_from;
+  std::exception_ptr error;
+
+  using cancellation_slot_type = asio::cancellation_slot;
+  cancellation_slot_type get_cancellation_slot() const {return slot;}
+
+  using executor_type = executor;
+  const executor_type & get_executor() const {return exec;}
+
+#if !defined(BOOST_COBALT_NO_PMR)
+  using allocator_type = pmr::polymorphic_allocator<void>;
+  allocator_type get_allocator() const {return allocator_type{this_thread::get_default_resource()};}
+
+#endif
+
+  template<typename Awaiter>
+  void * operator new(const std::size_t size, Awaiter &, with_timeout_storage & st)
+  {
+    return st.resource.allocate(size);
+  }
+
+  // released with the storage.
+  void operator delete(void *) noexcept {}
+
+  std::suspend_always initial_suspend() noexcept {return {};}
+
+  // the frame gets destroyed by with_timeout_impl, after the result got taken from the awaiter.
+  auto final_suspend() noexcept
+  {
+    struct final_awaitable
+    {
+      std::coroutine_handle<void> awaited_from;
+      bool await_ready() noexcept {return false;}
+      std::coroutine_handle<void> await_suspend(std::coroutine_handle<void>) noexcept {return awaited_from;}
+      void await_resume() noexcept {}
+    };
+    return final_awaitable{awaited_from};
+  }
+
+  void return_void() {}
+  void unhandled_exception() {error = std::current_exception();}
+
+  std::coroutine_handle<with_timeout_promise> get_return_object()
+  {
+    return std::coroutine_handle<with_timeout_promise>::from_promise(*this);
+  }
+};
+
+}
+
+namespace std
+{
+
+template <typename ... Args>
+struct coroutine_traits<coroutine_handle<boost::cobalt::detail::with_timeout_promise>, Args...>
+{
+  using promise_type = boost::cobalt::detail::with_timeout_promise;
+};
+
+} // namespace std
+
+namespace boost::cobalt::detail
+{
+
+// Only suspends, the result gets taken from the awaiter by with_timeout_impl.
+template<typename Awaiter>
+struct with_timeout_suspend
+{
+  Awaiter & awaiter;
+  constexpr bool await_ready() noexcept {return false;}
+  auto await_suspend(std::coroutine_handle<with_timeout_promise> h) {return awaiter.await_suspend(h);}
+  constexpr void await_resume() noexcept {}
+};
+
+template<typename Awaiter>
+std::coroutine_handle<with_timeout_promise> with_timeout_frame(Awaiter & awaiter, with_timeout_storage &)
+{
+  co_await with_timeout_suspend<Awaiter>{awaiter};
+}
+
+template<typename Awaitable>
+struct with_timeout_impl
+{
+  using awaiter_type = decltype(get_awaitable_type(std::declval<Awaitable&&>()));
+  using result_type  = decltype(std::declval<awaiter_type>().await_resume());
+
+  with_timeout_impl(Awaitable && aw, std::chrono::steady_clock::duration timeout)
+      : aw_(static_cast<Awaitable&&>(aw)),
+        awaiter_(get_awaitable_type(static_cast<Awaitable&&>(aw_))),
+        timeout_(timeout)
+  {
+  }
+
+  // in case the awaiting coroutine gets destroyed while suspended.
+  ~with_timeout_impl()
+  {
+    remove_deadline(node_);
+    if (slot_.is_connected())
+      slot_.clear();
+    if (frame_)
+      frame_.destroy();
+  }
+
+  bool await_ready() {return awaiter_.await_ready();}
+
+  template<typename Promise>
+  std::coroutine_handle<void> await_suspend(std::coroutine_handle<Promise> h)
+  {
+    frame_ = with_timeout_frame(awaiter_, storage_);
+    auto & fp = frame_.promise();
+    fp.slot = node_.signal.slot();
+    fp.exec = detail::get_executor(h);
+    fp.awaited_from = h;
+
+    // the awaited op gets cancelled by the deadline or the cancellation of the awaiting coroutine,
+    // which goes through its own cancellation state, i.e. gets filtered & recorded as usual.
+    if constexpr (requires {h.promise().get_cancellation_slot();})
+      if ((slot_ = h.promise().get_cancellation_slot()).is_connected())
+        slot_.assign([sig = &node_.signal](asio::cancellation_type ct) {sig->emit(ct);});
+
+    node_.expiry = std::chrono::steady_clock::now() + timeout_;
+    add_deadline(fp.exec, node_);
+    return frame_;
+  }
+
+  system::result<result_type> await_resume()
+  {
+    remove_deadline(node_);
+    if (slot_.is_connected())
+      slot_.clear();
+    if (frame_)
+    {
+      auto ep = std::move(frame_.promise().error);
+      std::exchange(frame_, nullptr).destroy();
+      if (ep)
+        std::rethrow_exception(ep);
+    }
+
+    try
+    {
+      if constexpr (std::is_void_v<result_type>)
+      {
+        awaiter_.await_resume();
+        return system::in_place_value;
+      }
+      else
+        return {system::in_place_value, awaiter_.await_resume()};
+    }
+    catch (system::system_error & se)
+    {
+      if (!node_.expired || se.code() != asio::error::operation_aborted)
+        throw;
+    }
+    constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION};
+    return {system::in_place_error, system::error_code(asio::error::timed_out, &loc)};
+  }
+
+ private:
+  Awaitable aw_;
+  awaiter_type awaiter_;
+  std::chrono::steady_clock::duration timeout_;
+  deadline_node node_;
+
+  asio::cancellation_slot slot_;
+  with_timeout_storage storage_;
+  std::coroutine_handle<with_timeout_promise> frame_;
+};
+
+}
+
+#endif //BOOST_COBALT_DETAIL_WITH_TIMEOUT_HPP
@@ -0,0 +1,94 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_EVENT_HPP
+#define BOOST_COBALT_EVENT_HPP
+
+#include <boost/cobalt/this_thread.hpp>
+#include <boost/cobalt/detail/sync_waiter.hpp>
+
+#include <tuple>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+struct event
+{
+  enum reset_mode
+  {
+    // stays set until reset, set() resumes all waiters.
+    manual_reset,
+    // set() resumes a single waiter, or stays set until the next wait.
+    auto_reset
+  };
+
+  explicit event(reset_mode mode = manual_reset, bool initially_set = false,
+                 executor exec = this_thread::get_executor())
+      : executor_(std::move(exec)), mode_(mode), set_(initially_set) {}
+  // not movable.
+  event(event && rhs) noexcept = delete;
+  event & operator=(event && lhs) noexcept = delete;
+  // Destroys the waiting coroutines, like a channel.
+  BOOST_COBALT_DECL ~event();
+
+  using executor_type = executor;
+  const executor_type & get_executor() {return executor_;}
+
+  bool is_set() const {return set_;}
+
+  BOOST_COBALT_DECL void set();
+  void reset() {set_ = false;}
+
+  // end::outline[]
+ private:
+  struct wait_op : detail::sync_waiter
+  {
+    event * evt;
+
+    wait_op(event * evt, const boost::source_location & loc)
+        : detail::sync_waiter(evt->executor_, loc), evt(evt) {}
+
+    bool await_ready() const {return evt->set_;}
+
+    template<typename Promise>
+    BOOST_COBALT_MSVC_NOINLINE
+    std::coroutine_handle<void> await_suspend(std::coroutine_handle<Promise> h)
+    {
+      if (cancelled || await_ready())
+        return h; // interrupted or set.
+      enqueue(h, evt->waiters_);
+      return std::noop_coroutine();
+    }
+
+    BOOST_COBALT_DECL void await_resume();
+    BOOST_COBALT_DECL std::tuple<system::error_code> await_resume(const struct as_tuple_tag & );
+    BOOST_COBALT_DECL system::result<void> await_resume(const struct as_result_tag &);
+  };
+
+  executor_type executor_;
+  reset_mode mode_;
+  bool set_;
+  detail::sync_waiter_queue waiters_;
+ public:
+  [[nodiscard]] wait_op wait(const boost::source_location & loc = BOOST_CURRENT_LOCATION) {return {this, loc};}
+  /*
+  // tag::outline[]
+  // an awaitable that yields void
+  using __wait_op__ = __unspecified__;
+
+  // Wait for the event to be set.
+  __wait_op__ wait();
+  // end::outline[]
+   */
+  // tag::outline[]
+};
+// end::outline[]
+
+}
+
+#endif //BOOST_COBALT_EVENT_HPP
@@ -0,0 +1,33 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_HEDGE_HPP
+#define BOOST_COBALT_HEDGE_HPP
+
+#include <boost/cobalt/concepts.hpp>
+#include <boost/cobalt/detail/hedge.hpp>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+// Start an attempt by invoking the factory. If no attempt succeeded after the delay,
+// start another one, up to max_attempts. The first success wins & the other attempts get cancelled.
+// Returns the index of the winning attempt & its result.
+template<typename Factory>
+  requires awaitable<std::invoke_result_t<Factory&>>
+auto hedge(Factory && factory,
+           std::chrono::steady_clock::duration delay,
+           std::size_t max_attempts = 2u)
+// end::outline[]
+{
+  return detail::hedge_impl<Factory>{static_cast<Factory&&>(factory), delay, max_attempts};
+}
+
+}
+
+#endif //BOOST_COBALT_HEDGE_HPP
@@ -10,9 +10,13 @@
 
 #include <boost/cobalt/io/acceptor.hpp>
 #include <boost/cobalt/io/buffer.hpp>
+#include <boost/cobalt/io/caching_resolver.hpp>
+#include <boost/cobalt/io/connection_pool.hpp>
+#include <boost/cobalt/io/copy_range.hpp>
 #include <boost/cobalt/io/datagram_socket.hpp>
 #include <boost/cobalt/io/endpoint.hpp>
 #include <boost/cobalt/io/file.hpp>
+#include <boost/cobalt/io/mapped_file.hpp>
 #include <boost/cobalt/io/ops.hpp>
 #include <boost/cobalt/io/pipe.hpp>
 #include <boost/cobalt/io/random_access_device.hpp>
@@ -27,6 +27,12 @@ struct BOOST_SYMBOL_VISIBLE acceptor
   BOOST_COBALT_IO_DECL system::result<void> bind(endpoint ep);
   BOOST_COBALT_IO_DECL system::result<void> listen(int backlog = max_listen_connections); // int backlog = net::max_backlog()
   BOOST_COBALT_IO_DECL endpoint local_endpoint();
+
+  // Open a listening acceptor with SO_REUSEPORT set, so that multiple acceptors, e.g. one per shard,
+  // can listen on the same endpoint & the kernel distributes the connections between them.
+  BOOST_COBALT_IO_DECL static system::result<acceptor> reuse_port(
+      endpoint ep, int backlog = max_listen_connections,
+      const cobalt::executor & executor = this_thread::get_executor());
  private:
   struct BOOST_COBALT_IO_DECL accept_op final : op<system::error_code>
   {
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_IO_CACHING_RESOLVER_HPP
+#define BOOST_COBALT_IO_CACHING_RESOLVER_HPP
+
+#include <boost/cobalt/io/resolver.hpp>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace boost::cobalt::io
+{
+
+// A resolver that caches results & shares lookups that are in flight.
+struct BOOST_SYMBOL_VISIBLE caching_resolver
+{
+  // Uses a system_resolver_backend.
+  BOOST_COBALT_IO_DECL explicit caching_resolver(const executor & exec = this_thread::get_executor());
+  // The backend must outlive the caching_resolver.
+  BOOST_COBALT_IO_DECL explicit caching_resolver(resolver_backend & backend,
+                                                 const executor & exec = this_thread::get_executor());
+  caching_resolver(caching_resolver && ) = delete;
+  // Pending lookups complete with operation_aborted.
+  BOOST_COBALT_IO_DECL ~caching_resolver();
+
+  // How long successful & failed lookups are cached.
+  std::chrono::steady_clock::duration ttl = std::chrono::seconds(30);
+  std::chrono::steady_clock::duration negative_ttl = std::chrono::seconds(5);
+  // Expired entries get purged once this many are cached, then the oldest ones if still full.
+  // Pending lookups don't get evicted, so they can exceed the limit.
+  std::size_t max_entries = 1024u;
+
+  // Add a static entry like a line in /etc/hosts. It never expires & takes precedence over the backend.
+  BOOST_COBALT_IO_DECL system::result<void> add_host(std::string_view host, std::string_view address);
+  // Add the static entries from the content of a hosts file.
+  BOOST_COBALT_IO_DECL system::result<void> load_hosts(std::string_view content);
+
+  // Drop cached results. This does not affect static entries or pending lookups.
+  BOOST_COBALT_IO_DECL void erase(std::string_view host, std::string_view service);
+  BOOST_COBALT_IO_DECL void clear();
+  // The amount of cached entries, including pending lookups.
+  std::size_t size() const {return cache_.size();}
+
+ private:
+  struct entry_;
+  struct BOOST_COBALT_IO_DECL resolve_op_ final : op<system::error_code, endpoint_sequence>
+  {
+    void ready(handler<system::error_code, endpoint_sequence> h) final override;
+    void initiate(completion_handler<system::error_code, endpoint_sequence> h) final override;
+
+    resolve_op_(caching_resolver & resolver, std::string_view host, std::string_view service)
+        : resolver_(resolver), host_(host), service_(service) {}
+    ~resolve_op_() = default;
+   private:
+    caching_resolver & resolver_;
+    std::string_view host_;
+    std::string_view service_;
+  };
+
+ public:
+  [[nodiscard]] auto resolve(std::string_view host, std::string_view service)
+  {
+    return resolve_op_{*this, host, service};
+  }
+
+ private:
+  struct key_compare_
+  {
+    using is_transparent = void;
+    template<typename T, typename U>
+    bool operator()(const T & lhs, const U & rhs) const
+    {
+      return std::pair<std::string_view, std::string_view>(lhs) < std::pair<std::string_view, std::string_view>(rhs);
+    }
+  };
+
+  void purge_();
+  static promise<void> lookup_(asio::executor_arg_t, executor, resolver_backend & backend,
+                               std::shared_ptr<entry_> e,
+                               std::chrono::steady_clock::duration ttl,
+                               std::chrono::steady_clock::duration negative_ttl);
+
+  executor executor_;
+  std::optional<system_resolver_backend> system_backend_;
+  resolver_backend & backend_;
+  std::map<std::pair<std::string, std::string>, std::shared_ptr<entry_>, key_compare_> cache_;
+  std::map<std::string, endpoint_sequence, std::less<>> hosts_;
+};
+
+}
+
+#endif //BOOST_COBALT_IO_CACHING_RESOLVER_HPP
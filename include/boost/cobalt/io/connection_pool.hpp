@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_IO_CONNECTION_POOL_HPP
+#define BOOST_COBALT_IO_CONNECTION_POOL_HPP
+
+#include <boost/cobalt/io/endpoint.hpp>
+#include <boost/cobalt/io/socket.hpp>
+#include <boost/cobalt/io/stream.hpp>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace boost::cobalt::io
+{
+
+// A type erased connect operation, so that the pool can hold any kind of stream.
+struct BOOST_COBALT_IO_DECL connect_stream_op final : op<system::error_code, std::unique_ptr<stream>>
+{
+  endpoint ep;
+
+  using implementation_t = void(void*, endpoint, completion_handler<system::error_code, std::unique_ptr<stream>>);
+
+  BOOST_COBALT_MSVC_NOINLINE
+  connect_stream_op(endpoint ep, void * this_, implementation_t * implementation)
+      : ep(ep), this_(this_), implementation_(implementation)
+  {}
+
+  void initiate(completion_handler<system::error_code, std::unique_ptr<stream>> handler) final
+  {
+    implementation_(this_, ep, std::move(handler));
+  }
+  ~connect_stream_op() = default;
+
+ private:
+  void * this_;
+  implementation_t * implementation_;
+};
+
+// Creates connected streams for a connection_pool.
+struct BOOST_SYMBOL_VISIBLE connector
+{
+  virtual ~connector() = default;
+  [[nodiscard]] virtual connect_stream_op connect(endpoint ep) = 0;
+};
+
+// Connects a stream_socket.
+struct BOOST_SYMBOL_VISIBLE tcp_connector final : connector
+{
+  BOOST_COBALT_IO_DECL tcp_connector(const executor & exec = this_thread::get_executor());
+
+  [[nodiscard]] connect_stream_op connect(endpoint ep) override
+  {
+    return {ep, this, initiate_connect_};
+  }
+ private:
+  BOOST_COBALT_IO_DECL static void initiate_connect_(void *, endpoint,
+                                                     completion_handler<system::error_code, std::unique_ptr<stream>>);
+  executor executor_;
+};
+
+// Keeps connections open for reuse. Connections are keyed by endpoint & connector,
+// e.g. an ssl::connector per ssl context.
+struct BOOST_SYMBOL_VISIBLE connection_pool
+{
+  // Uses a tcp_connector.
+  BOOST_COBALT_IO_DECL explicit connection_pool(const executor & exec = this_thread::get_executor());
+  connection_pool(connection_pool && ) = delete;
+  // Waiters complete with operation_aborted. Leases & acquires that are connecting must not outlive the pool.
+  BOOST_COBALT_IO_DECL ~connection_pool();
+
+  // The limits per key. max_total includes connections that are idle, leased or being established.
+  std::size_t max_idle = 8u;
+  std::size_t max_total = 64u;
+  // Idle connections older than this get closed instead of reused.
+  std::chrono::steady_clock::duration idle_timeout = std::chrono::seconds(60);
+
+ private:
+  struct key_entry_;
+ public:
+
+  // A connection taken from the pool. It returns to the pool on destruction, unless discarded.
+  struct BOOST_SYMBOL_VISIBLE lease
+  {
+    lease() = default;
+    BOOST_COBALT_IO_DECL lease(lease && lhs) noexcept;
+    BOOST_COBALT_IO_DECL lease& operator=(lease && lhs) noexcept;
+    BOOST_COBALT_IO_DECL ~lease();
+
+    explicit operator bool() const {return stream_ != nullptr;}
+    stream & operator*()  const {return *stream_;}
+    stream * operator->() const {return stream_.get();}
+    // The socket of the stream, or nullptr if it isn't one.
+    io::socket * socket() const {return socket_;}
+
+    // Access the concrete stream type, e.g. stream_socket or ssl::stream.
+    template<typename Stream>
+    Stream & get() const {return dynamic_cast<Stream&>(*stream_);}
+
+    // If the connection was taken from the idle list, i.e. it has been used before.
+    bool reused() const {return reused_;}
+
+    // Close the connection instead of returning it, e.g. after an error or a protocol without keep-alive.
+    void discard() {discard_ = true;}
+    // Return the connection to the pool now.
+    BOOST_COBALT_IO_DECL void release();
+
+   private:
+    friend struct connection_pool;
+    lease(connection_pool & pool, key_entry_ & entry, std::unique_ptr<stream> s, bool reused);
+
+    connection_pool * pool_ = nullptr;
+    key_entry_ * entry_ = nullptr;
+    std::unique_ptr<stream> stream_;
+    io::socket * socket_ = nullptr;
+    bool reused_ = false;
+    bool discard_ = false;
+  };
+
+ private:
+  struct BOOST_COBALT_IO_DECL acquire_op_ final : op<system::error_code, lease>
+  {
+    void ready(handler<system::error_code, lease> h) final override;
+    void initiate(completion_handler<system::error_code, lease> h) final override;
+
+    acquire_op_(connection_pool & pool, endpoint ep, connector & con)
+        : pool_(pool), ep_(ep), connector_(con) {}
+    ~acquire_op_() = default;
+   private:
+    connection_pool & pool_;
+    endpoint ep_;
+    connector & connector_;
+  };
+
+  // Waits for a free slot or a returned connection.
+  struct BOOST_COBALT_IO_DECL wait_op_ final : op<system::error_code, lease>
+  {
+    void initiate(completion_handler<system::error_code, lease> h) final override;
+
+    wait_op_(key_entry_ & entry) : entry_(entry) {}
+    ~wait_op_() = default;
+   private:
+    key_entry_ & entry_;
+  };
+
+ public:
+  // Get an idle connection or establish a new one. If the key is at max_total, this waits in FIFO order.
+  [[nodiscard]] acquire_op_ acquire(endpoint ep) {return {*this, ep, tcp_};}
+  // The connector must outlive the pool.
+  [[nodiscard]] acquire_op_ acquire(endpoint ep, connector & con) {return {*this, ep, con};}
+
+  // Close expired idle connections.
+  BOOST_COBALT_IO_DECL void purge();
+  // Close all idle connections.
+  BOOST_COBALT_IO_DECL void clear();
+
+  // The amount of idle connections.
+  BOOST_COBALT_IO_DECL std::size_t idle() const;
+  // The amount of connections, including the ones that are leased or being established.
+  BOOST_COBALT_IO_DECL std::size_t size() const;
+
+ private:
+  key_entry_ & entry_for_(const endpoint & ep, connector & con);
+  lease pop_idle_(key_entry_ & e);
+  void return_(key_entry_ & e, std::unique_ptr<stream> s, bool discard);
+
+  tcp_connector tcp_;
+  // acquires that are establishing a connection, they must complete before the pool gets destroyed.
+  std::size_t connecting_ = 0u;
+  std::map<std::string, std::unique_ptr<key_entry_>, std::less<>> entries_;
+};
+
+}
+
+#endif //BOOST_COBALT_IO_CONNECTION_POOL_HPP
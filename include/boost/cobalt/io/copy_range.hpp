@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_IO_COPY_RANGE_HPP
+#define BOOST_COBALT_IO_COPY_RANGE_HPP
+
+#include <boost/cobalt/io/random_access_file.hpp>
+#include <boost/cobalt/op.hpp>
+
+#include <concepts>
+#include <memory>
+
+namespace boost::cobalt::io
+{
+
+struct BOOST_COBALT_IO_DECL copy_range_op final : op<system::error_code, std::uint64_t>
+{
+  using progress_t = void(void*, std::uint64_t);
+
+  copy_range_op(random_access_file & source,      std::uint64_t source_offset,
+                random_access_file & destination, std::uint64_t destination_offset,
+                std::uint64_t length,
+                void * progress_this = nullptr, progress_t * progress = nullptr)
+      : source_(source), source_offset_(source_offset),
+        destination_(destination), destination_offset_(destination_offset),
+        length_(length), progress_this_(progress_this), progress_(progress)
+  {}
+
+  // The amount of bytes copied in one step. Progress gets reported & cancellation checked after each.
+  std::size_t chunk_size = 1024u * 1024u;
+
+  void ready(handler<system::error_code, std::uint64_t> h) final
+  {
+    if (length_ == 0u)
+      h({}, 0u);
+  }
+
+  void initiate(completion_handler<system::error_code, std::uint64_t>) final;
+  ~copy_range_op() = default;
+
+ private:
+  random_access_file & source_;
+  std::uint64_t source_offset_;
+  random_access_file & destination_;
+  std::uint64_t destination_offset_;
+  std::uint64_t length_;
+
+  void * progress_this_;
+  progress_t * progress_;
+};
+
+[[nodiscard]] inline
+copy_range_op copy_range(random_access_file & source,      std::uint64_t source_offset,
+                         random_access_file & destination, std::uint64_t destination_offset,
+                         std::uint64_t length)
+{
+  return {source, source_offset, destination, destination_offset, length};
+}
+
+// The progress function gets invoked with the total amount of bytes copied so far & needs to outlive the op.
+template<typename Progress>
+  requires std::invocable<Progress&, std::uint64_t>
+[[nodiscard]] BOOST_COBALT_MSVC_NOINLINE
+copy_range_op copy_range(random_access_file & source,      std::uint64_t source_offset,
+                         random_access_file & destination, std::uint64_t destination_offset,
+                         std::uint64_t length, Progress && progress)
+{
+  return {source, source_offset, destination, destination_offset, length,
+          const_cast<void*>(static_cast<const void*>(std::addressof(progress))),
+          +[](void * p, std::uint64_t n) {(*static_cast<std::remove_reference_t<Progress>*>(p))(n);}};
+}
+
+}
+
+#endif //BOOST_COBALT_IO_COPY_RANGE_HPP
@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_IO_MAPPED_FILE_HPP
+#define BOOST_COBALT_IO_MAPPED_FILE_HPP
+
+#include <boost/cobalt/config.hpp>
+#include <boost/cobalt/io/file.hpp>
+#include <boost/cobalt/op.hpp>
+
+#include <boost/system/result.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+
+#if !defined(BOOST_ASIO_WINDOWS)
+
+namespace boost::cobalt::io
+{
+
+// A read-mostly view of a file range mapped into memory.
+struct BOOST_SYMBOL_VISIBLE mapped_file
+{
+  enum access
+  {
+    read_only,
+    read_write
+  };
+
+  enum hints : unsigned
+  {
+    none       = 0u,
+    populate   = 1u, // fault in the whole range when mapping (MAP_POPULATE)
+    huge_pages = 2u, // ask for transparent huge pages (MADV_HUGEPAGE)
+    sequential = 4u, // MADV_SEQUENTIAL
+    random     = 8u  // MADV_RANDOM
+  };
+
+  friend hints operator|(hints x, hints y) {return static_cast<hints>(static_cast<unsigned>(x) | static_cast<unsigned>(y));}
+  friend hints operator&(hints x, hints y) {return static_cast<hints>(static_cast<unsigned>(x) & static_cast<unsigned>(y));}
+
+  constexpr static std::size_t npos = static_cast<std::size_t>(-1);
+
+  // Pages are faulted in on a background thread, so the awaiting coroutine never takes a major fault.
+  struct BOOST_COBALT_IO_DECL prefetch_op final : op<system::error_code>
+  {
+    prefetch_op(const char * data, std::size_t size) : data_(data), size_(size) {}
+
+    void ready(handler<system::error_code> h) final override
+    {
+      if (size_ == 0u)
+        h({});
+    }
+    void initiate(completion_handler<system::error_code> h) final override;
+    ~prefetch_op() = default;
+   private:
+    const char * data_;
+    std::size_t size_;
+  };
+
+  mapped_file() noexcept = default;
+  // Map the full file.
+  BOOST_COBALT_IO_DECL explicit mapped_file(file & f, access acc = read_only, hints hs = none);
+  BOOST_COBALT_IO_DECL mapped_file(file & f, std::uint64_t offset, std::size_t length,
+                                   access acc = read_only, hints hs = none);
+  BOOST_COBALT_IO_DECL mapped_file(mapped_file && lhs) noexcept;
+  BOOST_COBALT_IO_DECL mapped_file& operator=(mapped_file && lhs) noexcept;
+  BOOST_COBALT_IO_DECL ~mapped_file();
+
+  // If length is npos, the rest of the file starting at offset will be mapped.
+  BOOST_COBALT_IO_DECL system::result<void> map(file::native_handle_type fd,
+                                                std::uint64_t offset, std::size_t length = npos,
+                                                access acc = read_only, hints hs = none);
+  BOOST_COBALT_IO_DECL system::result<void> unmap();
+
+  bool is_mapped() const {return data_ != nullptr;}
+  // The file offset of the first byte of the view.
+  std::uint64_t offset() const {return offset_;}
+  std::size_t size() const {return size_;}
+
+  const char * data() const {return data_;}
+  char * data() {return data_;}
+
+  // Get a sub view of the mapping, clamped to its bounds.
+  std::span<const char> view(std::size_t pos = 0u, std::size_t n = npos) const
+  {
+    pos = (std::min)(pos, size_);
+    return {data_ + pos, (std::min)(n, size_ - pos)};
+  }
+
+  std::span<char> mutable_view(std::size_t pos = 0u, std::size_t n = npos)
+  {
+    pos = (std::min)(pos, size_);
+    return {data_ + pos, (std::min)(n, size_ - pos)};
+  }
+
+  // Write back dirty pages. If async is false, this blocks until the data is on disk.
+  BOOST_COBALT_IO_DECL system::result<void> flush(bool async = true);
+
+  // Load the given range of the view into memory.
+  [[nodiscard]] prefetch_op prefetch(std::size_t pos = 0u, std::size_t n = npos) const
+  {
+    auto v = view(pos, n);
+    return {v.data(), v.size()};
+  }
+
+ private:
+  char * data_ = nullptr;
+  std::size_t size_ = 0u;
+  std::uint64_t offset_ = 0u;
+  // the actual mapping, starting at a page boundary.
+  void * base_ = nullptr;
+  std::size_t base_size_ = 0u;
+};
+
+}
+
+#endif
+
+#endif //BOOST_COBALT_IO_MAPPED_FILE_HPP
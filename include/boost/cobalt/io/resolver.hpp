@@ -56,6 +56,56 @@ struct BOOST_SYMBOL_VISIBLE resolver
   asio::ip::basic_resolver<protocol_type, executor> resolver_;
 };
 
+// A type erased resolve operation, so that resolvers can be customized.
+struct BOOST_COBALT_IO_DECL resolve_op final : op<system::error_code, endpoint_sequence>
+{
+  std::string_view host;
+  std::string_view service;
+
+  using implementation_t = void(void*, std::string_view, std::string_view, completion_handler<system::error_code, endpoint_sequence>);
+
+  BOOST_COBALT_MSVC_NOINLINE
+  resolve_op(std::string_view host, std::string_view service,
+             void * this_, implementation_t * implementation)
+      : host(host), service(service), this_(this_), implementation_(implementation)
+  {}
+
+  void initiate(completion_handler<system::error_code, endpoint_sequence> handler) final
+  {
+    implementation_(this_, host, service, std::move(handler));
+  }
+  ~resolve_op() = default;
+
+ private:
+  void * this_;
+  implementation_t * implementation_;
+};
+
+struct BOOST_SYMBOL_VISIBLE resolver_backend
+{
+  virtual ~resolver_backend() = default;
+  [[nodiscard]] virtual resolve_op resolve(std::string_view host, std::string_view service) = 0;
+};
+
+// The default backend, using the system resolver, i.e. getaddrinfo.
+struct BOOST_SYMBOL_VISIBLE system_resolver_backend final : resolver_backend
+{
+  BOOST_COBALT_IO_DECL system_resolver_backend(const executor & exec = this_thread::get_executor(),
+                                               resolver::flags flags = {});
+
+  [[nodiscard]] resolve_op resolve(std::string_view host, std::string_view service) override
+  {
+    return {host, service, this, initiate_resolve_};
+  }
+
+  BOOST_COBALT_IO_DECL void cancel();
+ private:
+  BOOST_COBALT_IO_DECL static void initiate_resolve_(void *, std::string_view, std::string_view,
+                                                     completion_handler<system::error_code, endpoint_sequence>);
+  asio::ip::basic_resolver<protocol_type, executor> resolver_;
+  resolver::flags flags_;
+};
+
 struct BOOST_COBALT_IO_DECL lookup final : op<system::error_code, endpoint_sequence>
 {
   lookup(std::string_view host, std::string_view service,
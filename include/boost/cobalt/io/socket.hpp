@@ -10,9 +10,13 @@
 
 #include <boost/cobalt/io/endpoint.hpp>
 #include <boost/cobalt/io/ops.hpp>
+#include <boost/cobalt/promise.hpp>
 #include <boost/asio/socket_base.hpp>
 #include <boost/asio/basic_socket.hpp>
 
+#include <chrono>
+#include <optional>
+
 
 namespace boost::cobalt::io
 {
@@ -138,6 +142,32 @@ struct BOOST_SYMBOL_VISIBLE socket
     return {std::move(ep), *this};
   }
 
+  // Connects like RFC 8305 (happy eyeballs), i.e. attempts overlap.
+  struct BOOST_COBALT_IO_DECL staggered_connect_op final : op<system::error_code, endpoint>
+  {
+    endpoint_sequence endpoints;
+    std::chrono::steady_clock::duration delay;
+
+    void initiate(boost::cobalt::completion_handler<system::error_code, endpoint>) final;
+
+    staggered_connect_op(endpoint_sequence eps, std::chrono::steady_clock::duration delay, socket & socket) :
+        endpoints(eps), delay(delay), sock_(socket) {}
+    ~staggered_connect_op() = default;
+   private:
+    static promise<void> run_(asio::executor_arg_t, executor, staggered_connect_op & op,
+                              boost::cobalt::completion_handler<system::error_code, endpoint> handler);
+    socket & sock_;
+    std::optional<promise<void>> runner_;
+  };
+
+  // Start a connection attempt every delay or when the previous one failed, whichever comes first.
+  // The first successful connection will be used and all others cancelled.
+  // Every attempt uses a new socket, the winner replaces this socket, i.e. options need to be set afterwards.
+  [[nodiscard]] staggered_connect_op connect(endpoint_sequence ep, std::chrono::steady_clock::duration delay)
+  {
+    return {std::move(ep), delay, *this};
+  }
+
 
  protected:
   virtual void adopt_endpoint_(endpoint & ) {}
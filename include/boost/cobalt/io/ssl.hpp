@@ -9,13 +9,19 @@
 #ifndef BOOST_COBALT_SSL_HPP
 #define BOOST_COBALT_SSL_HPP
 
+#include <boost/cobalt/io/connection_pool.hpp>
 #include <boost/cobalt/io/socket.hpp>
 #include <boost/cobalt/io/stream.hpp>
 
+#include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/generic/datagram_protocol.hpp>
 #include <boost/asio/basic_stream_socket.hpp>
 #include <boost/asio/ssl/stream.hpp>
 
+#include <chrono>
+#include <memory>
+#include <string>
+
 
 namespace boost::cobalt::io::ssl
 {
@@ -83,13 +89,12 @@ struct BOOST_SYMBOL_VISIBLE stream final : private detail::stream_impl, socket,
   {
     void ready(handler<system::error_code> h) final;
     void initiate(completion_handler<system::error_code> h) final;
-    handshake_op_(handshake_type type, bool upgraded, asio::ssl::stream<asio::basic_stream_socket<protocol_type, executor>>  & stream_socket)
-        : type_(type), upgraded_(upgraded), stream_socket_(stream_socket) {}
+    handshake_op_(handshake_type type, stream & stream_)
+        : type_(type), stream_(stream_) {}
     ~handshake_op_() = default;
    private:
     handshake_type type_;
-    bool upgraded_;
-    asio::ssl::stream<asio::basic_stream_socket<protocol_type, executor>> &stream_socket_;
+    stream & stream_;
   };
 
 
@@ -97,15 +102,13 @@ struct BOOST_SYMBOL_VISIBLE stream final : private detail::stream_impl, socket,
   {
     void ready(handler<system::error_code, std::size_t> h) final;
     void initiate(completion_handler<system::error_code, std::size_t> h) final;
-    handshake_buffer_op_(handshake_type type, bool upgraded, const_buffer_sequence buffer_,
-                         asio::ssl::stream<asio::basic_stream_socket<protocol_type, executor>>  & stream_socket)
-        : type_(type), upgraded_(upgraded), buffer_(buffer_), stream_socket_(stream_socket) {}
+    handshake_buffer_op_(handshake_type type, const_buffer_sequence buffer_, stream & stream_)
+        : type_(type), buffer_(buffer_), stream_(stream_) {}
     ~handshake_buffer_op_() = default;
    private:
     handshake_type type_;
-    bool upgraded_;
     const_buffer_sequence buffer_;
-    asio::ssl::stream<asio::basic_stream_socket<protocol_type, executor>> &stream_socket_;
+    stream & stream_;
   };
 
 
@@ -121,14 +124,37 @@ struct BOOST_SYMBOL_VISIBLE stream final : private detail::stream_impl, socket,
     asio::ssl::stream<asio::basic_stream_socket<protocol_type, executor>> &stream_socket_;
   };
  public:
-  [[nodiscard]] auto handshake(handshake_type type) { return handshake_op_{type, upgraded_, stream_socket_}; }
+  [[nodiscard]] auto handshake(handshake_type type) { return handshake_op_{type, *this}; }
   [[nodiscard]] auto handshake(handshake_type type, const_buffer_sequence buffer)
   {
-    return handshake_buffer_op_{type, upgraded_, buffer, stream_socket_};
+    return handshake_buffer_op_{type, buffer, *this};
   }
   [[nodiscard]] auto shutdown() { return shutdown_op_{upgraded_, stream_socket_}; }
+
+  // Set the server name indication for a client handshake. It's also used to key cached sessions.
+  BOOST_COBALT_SSL_DECL
+  system::result<void> set_server_name(std::string_view name);
+
+  // If the last handshake resumed a session, instead of performing a full handshake.
+  BOOST_COBALT_SSL_DECL
+  bool resumed() const;
+
+  // Run the handshake steps, i.e. the cpu heavy crypto, on another executor, e.g. a thread_pool.
+  // The handshake still completes on the executor of the awaiting coroutine. A null executor disables it.
+  void set_handshake_executor(asio::any_io_executor exec) {handshake_executor_ = std::move(exec);}
+
+  // Dynamic record sizing: until record_boost_threshold bytes have been written, and again after the stream
+  // was idle for record_idle_reset, writes produce records that fit into a single tcp segment,
+  // so the peer can decrypt the first bytes early. Afterwards records are filled up to max_record_size.
+  constexpr static std::size_t max_record_size = 16384u;
+  std::size_t small_record_size = 1369u;
+  std::size_t record_boost_threshold = 1024u * 1024u;
+  std::chrono::steady_clock::duration record_idle_reset = std::chrono::seconds(1);
  private:
 
+  // Prepares the session resumption, if the context has a session_cache.
+  BOOST_COBALT_SSL_DECL void prepare_handshake_(handshake_type type);
+
   BOOST_COBALT_SSL_DECL void adopt_endpoint_(endpoint & ep) override;
 
   BOOST_COBALT_SSL_DECL static void initiate_read_some_ (void *, mutable_buffer_sequence, cobalt::completion_handler<system::error_code, std::size_t>);
@@ -136,6 +162,56 @@ struct BOOST_SYMBOL_VISIBLE stream final : private detail::stream_impl, socket,
 
 
   bool upgraded_ = false;
+  std::string session_key_;
+  asio::any_io_executor handshake_executor_;
+
+  BOOST_COBALT_SSL_DECL std::size_t record_limit_();
+  std::unique_ptr<char[]> record_buffer_;
+  std::size_t bytes_written_ = 0u;
+  std::chrono::steady_clock::time_point last_write_;
+};
+
+// A client side cache of tls sessions, so that handshakes to a known server can be resumed.
+// Sessions are keyed by server name and remote endpoint.
+struct BOOST_SYMBOL_VISIBLE session_cache
+{
+  BOOST_COBALT_SSL_DECL explicit session_cache(std::size_t max_entries = 256u);
+  session_cache(session_cache && ) = delete;
+  BOOST_COBALT_SSL_DECL ~session_cache();
+
+  // Enables client side session caching on the context. The cache must outlive the context.
+  BOOST_COBALT_SSL_DECL system::result<void> attach(context & ctx);
+
+  // The oldest session gets evicted once this many are cached.
+  std::size_t max_entries;
+
+  BOOST_COBALT_SSL_DECL std::size_t size() const;
+  BOOST_COBALT_SSL_DECL void clear();
+
+ private:
+  friend struct stream;
+  static int new_session_(SSL * ssl, SSL_SESSION * session);
+  struct impl;
+  std::unique_ptr<impl> impl_;
+};
+
+// Replace the keys a server uses to encrypt session tickets. Tickets issued with the old keys can't be resumed.
+BOOST_COBALT_SSL_DECL system::result<void> rotate_ticket_keys(context & ctx);
+
+// Connects an ssl stream & performs the client handshake, e.g. for a connection_pool.
+struct BOOST_SYMBOL_VISIBLE connector final : io::connector
+{
+  BOOST_COBALT_SSL_DECL connector(context & ctx, const cobalt::executor & executor = this_thread::get_executor());
+
+  [[nodiscard]] connect_stream_op connect(endpoint ep) override
+  {
+    return {ep, this, initiate_connect_};
+  }
+ private:
+  BOOST_COBALT_SSL_DECL static void initiate_connect_(void *, endpoint,
+                                                      completion_handler<system::error_code, std::unique_ptr<io::stream>>);
+  context & context_;
+  cobalt::executor executor_;
 };
 
 }
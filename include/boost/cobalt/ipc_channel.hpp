@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_IPC_CHANNEL_HPP
+#define BOOST_COBALT_IPC_CHANNEL_HPP
+
+#include <boost/cobalt/config.hpp>
+
+#if defined(__linux__)
+
+#include <boost/cobalt/composition.hpp>
+#include <boost/cobalt/detail/ipc_channel.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/system/result.hpp>
+
+#include <type_traits>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+// A single producer, single consumer ring in shared memory, with an eventfd for each side to wake up the other.
+// It needs to be created before fork(), so that both processes share the mapping & the eventfds.
+struct ipc_ring
+{
+  BOOST_COBALT_DECL static system::result<ipc_ring> create(std::size_t capacity, std::size_t element_size);
+  template<typename T>
+  static system::result<ipc_ring> create(std::size_t capacity) {return create(capacity, sizeof(T));}
+
+  BOOST_COBALT_DECL ipc_ring(ipc_ring && lhs) noexcept;
+  BOOST_COBALT_DECL ipc_ring& operator=(ipc_ring && lhs) noexcept;
+  // Unmaps the ring & closes the eventfds in this process.
+  BOOST_COBALT_DECL ~ipc_ring();
+
+  std::size_t capacity() const {return header_->capacity;}
+  std::size_t element_size() const {return header_->element_size;}
+  // end::outline[]
+
+ private:
+  friend struct detail::ipc_channel_base;
+  ipc_ring() = default;
+
+  detail::ipc_ring_header * header_ = nullptr;
+  std::size_t mapped_size_ = 0u;
+  int readable_fd_ = -1;
+  int writable_fd_ = -1;
+  // tag::outline[]
+};
+
+// One end of an ipc_ring. Each process creates its own on its executor;
+// one of them only writes & the other only reads.
+template<typename T>
+  requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+struct ipc_channel : detail::ipc_channel_base
+{
+  // Throws if the element_size of the ring doesn't match.
+  explicit ipc_channel(ipc_ring & ring, const executor & exec = this_thread::get_executor());
+
+  // end::outline[]
+  /* tag::outline[]
+  // How often a read or write retries before waiting for the other side to wake it up.
+  std::size_t spin = 0u;
+
+  bool is_open() const;
+  // Close the channel, the reader still gets the elements that have been written.
+  void close();
+  end::outline[] */
+ private:
+  struct read_op_ final : op<system::error_code, T>
+  {
+    void ready(handler<system::error_code, T> h) final override
+    {
+      T value;
+      if (chan_.try_read_(&value) || chan_.spin_([&]{return chan_.try_read_(&value);}))
+        h({}, value);
+      else if (!chan_.is_open()) // the writer might have written before closing
+      {
+        if (chan_.try_read_(&value))
+          h({}, value);
+        else
+          h(asio::error::broken_pipe, T{});
+      }
+    }
+
+    void initiate(completion_handler<system::error_code, T>) final override
+    {
+      T value;
+      while (!chan_.try_read_(&value))
+      {
+        if (!chan_.is_open())
+        {
+          if (chan_.try_read_(&value))
+            break;
+          co_return {asio::error::broken_pipe, T{}};
+        }
+        auto [ec] = co_await wait_op_{chan_, true};
+        if (ec)
+          co_return {ec, T{}};
+      }
+      co_return {system::error_code{}, value};
+    }
+
+    read_op_(ipc_channel & chan) : chan_(chan) {}
+    ~read_op_() = default;
+   private:
+    ipc_channel & chan_;
+  };
+
+ public:
+  /* tag::outline[]
+  // Write the value, waiting while the ring is full. Fails with broken_pipe if closed.
+  [[nodiscard]] __write_op__ write(const T & value);
+  // Read the next value, waiting while the ring is empty. Fails with broken_pipe once closed & drained.
+  [[nodiscard]] __read_op__  read();
+  end::outline[] */
+  [[nodiscard]] write_op_ write(const T & value) {return {*this, &value};}
+  [[nodiscard]] read_op_ read() {return {*this};}
+  // tag::outline[]
+};
+// end::outline[]
+
+template<typename T>
+  requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+ipc_channel<T>::ipc_channel(ipc_ring & ring, const executor & exec)
+    : detail::ipc_channel_base(ring, sizeof(T), exec)
+{
+}
+
+}
+
+#endif
+
+#endif //BOOST_COBALT_IPC_CHANNEL_HPP
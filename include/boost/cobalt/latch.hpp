@@ -0,0 +1,94 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_LATCH_HPP
+#define BOOST_COBALT_LATCH_HPP
+
+#include <boost/cobalt/this_thread.hpp>
+#include <boost/cobalt/detail/sync_waiter.hpp>
+
+#include <tuple>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+// A single use counter, that resumes all waiters once it reaches zero.
+struct latch
+{
+  explicit latch(std::size_t count, executor exec = this_thread::get_executor())
+      : executor_(std::move(exec)), count_(count) {}
+  // not movable.
+  latch(latch && rhs) noexcept = delete;
+  latch & operator=(latch && lhs) noexcept = delete;
+  // Destroys the waiting coroutines, like a channel.
+  BOOST_COBALT_DECL ~latch();
+
+  using executor_type = executor;
+  const executor_type & get_executor() {return executor_;}
+
+  std::size_t count() const {return count_;}
+  // If the count reached zero.
+  bool try_wait() const {return count_ == 0u;}
+
+  // Decrement the counter. All waiters get resumed by a single post once it reaches zero.
+  BOOST_COBALT_DECL void count_down(std::size_t n = 1u);
+
+  // end::outline[]
+ private:
+  struct wait_op : detail::sync_waiter
+  {
+    latch * ltc;
+
+    wait_op(latch * ltc, const boost::source_location & loc)
+        : detail::sync_waiter(ltc->executor_, loc), ltc(ltc) {}
+
+    bool await_ready() const {return ltc->count_ == 0u;}
+
+    template<typename Promise>
+    BOOST_COBALT_MSVC_NOINLINE
+    std::coroutine_handle<void> await_suspend(std::coroutine_handle<Promise> h)
+    {
+      if (cancelled || await_ready())
+        return h; // interrupted or done.
+      enqueue(h, ltc->waiters_);
+      return std::noop_coroutine();
+    }
+
+    void await_resume() {result().value(loc);}
+    std::tuple<system::error_code> await_resume(const struct as_tuple_tag & ) {return result().error();}
+    system::result<void> await_resume(const struct as_result_tag &) {return result();}
+  };
+
+  executor_type executor_;
+  std::size_t count_;
+  detail::sync_waiter_queue waiters_;
+ public:
+  [[nodiscard]] wait_op wait(const boost::source_location & loc = BOOST_CURRENT_LOCATION) {return {this, loc};}
+  [[nodiscard]] wait_op arrive_and_wait(std::size_t n = 1u, const boost::source_location & loc = BOOST_CURRENT_LOCATION)
+  {
+    count_down(n);
+    return {this, loc};
+  }
+  /*
+  // tag::outline[]
+  // an awaitable that yields void
+  using __wait_op__ = __unspecified__;
+
+  // Wait for the count to reach zero.
+  __wait_op__ wait();
+  // count_down(n) & wait.
+  __wait_op__ arrive_and_wait(std::size_t n = 1u);
+  // end::outline[]
+   */
+  // tag::outline[]
+};
+// end::outline[]
+
+}
+
+#endif //BOOST_COBALT_LATCH_HPP
@@ -0,0 +1,169 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_MUTEX_HPP
+#define BOOST_COBALT_MUTEX_HPP
+
+#include <boost/cobalt/this_thread.hpp>
+#include <boost/cobalt/detail/sync_waiter.hpp>
+
+#include <tuple>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+struct mutex
+{
+  explicit mutex(executor exec = this_thread::get_executor()) : executor_(std::move(exec)) {}
+  // not movable.
+  mutex(mutex && rhs) noexcept = delete;
+  mutex & operator=(mutex && lhs) noexcept = delete;
+  // Destroys the waiting coroutines, like a channel.
+  BOOST_COBALT_DECL ~mutex();
+
+  using executor_type = executor;
+  const executor_type & get_executor() {return executor_;}
+
+  bool is_locked() const {return locked_;}
+
+  // Lock the mutex if that's possible without waiting.
+  BOOST_COBALT_DECL bool try_lock();
+  // Unlock the mutex, handing it to the next waiting coroutine in FIFO order.
+  BOOST_COBALT_DECL void unlock();
+
+  // end::outline[]
+ private:
+  struct lock_op : detail::sync_waiter
+  {
+    mutex * mtx;
+
+    lock_op(mutex * mtx, const boost::source_location & loc)
+        : detail::sync_waiter(mtx->executor_, loc), mtx(mtx) {}
+
+    // unlock hands the mutex to the waiters, so an unlocked mutex never has any.
+    bool await_ready() const {return !mtx->locked_;}
+
+    template<typename Promise>
+    BOOST_COBALT_MSVC_NOINLINE
+    std::coroutine_handle<void> await_suspend(std::coroutine_handle<Promise> h)
+    {
+      if (cancelled || await_ready())
+        return h; // interrupted or unlocked.
+      enqueue(h, mtx->waiters_);
+      return std::noop_coroutine();
+    }
+
+    BOOST_COBALT_DECL void await_resume();
+    BOOST_COBALT_DECL std::tuple<system::error_code> await_resume(const struct as_tuple_tag & );
+    BOOST_COBALT_DECL system::result<void> await_resume(const struct as_result_tag &);
+  };
+
+  executor_type executor_;
+  bool locked_ = false;
+  detail::sync_waiter_queue waiters_;
+ public:
+  [[nodiscard]] lock_op lock(const boost::source_location & loc = BOOST_CURRENT_LOCATION) {return {this, loc};}
+  /*
+  // tag::outline[]
+  // an awaitable that yields void
+  using __lock_op__ = __unspecified__;
+
+  // Wait for the mutex to be locked.
+  __lock_op__ lock();
+  // end::outline[]
+   */
+  // tag::outline[]
+};
+// end::outline[]
+
+// tag::shared_outline[]
+// A mutex with exclusive & shared ownership. Waiters are served in FIFO order,
+// so a shared lock waits for exclusive locks requested before it.
+struct shared_mutex
+{
+  explicit shared_mutex(executor exec = this_thread::get_executor()) : executor_(std::move(exec)) {}
+  // not movable.
+  shared_mutex(shared_mutex && rhs) noexcept = delete;
+  shared_mutex & operator=(shared_mutex && lhs) noexcept = delete;
+  // Destroys the waiting coroutines, like a channel.
+  BOOST_COBALT_DECL ~shared_mutex();
+
+  using executor_type = executor;
+  const executor_type & get_executor() {return executor_;}
+
+  bool is_locked() const {return locked_;}
+  // The amount of shared owners.
+  std::size_t shared_count() const {return shared_;}
+
+  BOOST_COBALT_DECL bool try_lock();
+  BOOST_COBALT_DECL void unlock();
+
+  BOOST_COBALT_DECL bool try_lock_shared();
+  BOOST_COBALT_DECL void unlock_shared();
+
+  // end::shared_outline[]
+ private:
+  struct lock_op : detail::sync_waiter
+  {
+    shared_mutex * mtx;
+
+    lock_op(shared_mutex * mtx, bool shared_, const boost::source_location & loc)
+        : detail::sync_waiter(mtx->executor_, loc), mtx(mtx)
+    {
+      shared = shared_;
+      owner = mtx;
+      on_cancel = +[](void * p) {static_cast<shared_mutex*>(p)->dispatch_();};
+    }
+
+    bool await_ready() const {return shared ? mtx->can_lock_shared_() : mtx->can_lock_();}
+
+    template<typename Promise>
+    BOOST_COBALT_MSVC_NOINLINE
+    std::coroutine_handle<void> await_suspend(std::coroutine_handle<Promise> h)
+    {
+      if (cancelled || await_ready())
+        return h; // interrupted or available.
+      enqueue(h, mtx->waiters_);
+      return std::noop_coroutine();
+    }
+
+    BOOST_COBALT_DECL void await_resume();
+    BOOST_COBALT_DECL std::tuple<system::error_code> await_resume(const struct as_tuple_tag & );
+    BOOST_COBALT_DECL system::result<void> await_resume(const struct as_result_tag &);
+  };
+
+  bool can_lock_() const        {return !locked_ && shared_ == 0u && waiters_.empty();}
+  bool can_lock_shared_() const {return !locked_ && waiters_.empty();}
+  // hand the mutex to the waiters at the front of the queue, if possible.
+  BOOST_COBALT_DECL void dispatch_();
+
+  executor_type executor_;
+  bool locked_ = false;
+  std::size_t shared_ = 0u;
+  detail::sync_waiter_queue waiters_;
+ public:
+  [[nodiscard]] lock_op lock       (const boost::source_location & loc = BOOST_CURRENT_LOCATION) {return {this, false, loc};}
+  [[nodiscard]] lock_op lock_shared(const boost::source_location & loc = BOOST_CURRENT_LOCATION) {return {this, true,  loc};}
+  /*
+  // tag::shared_outline[]
+  // an awaitable that yields void
+  using __lock_op__ = __unspecified__;
+
+  // Wait for exclusive ownership.
+  __lock_op__ lock();
+  // Wait for shared ownership.
+  __lock_op__ lock_shared();
+  // end::shared_outline[]
+   */
+  // tag::shared_outline[]
+};
+// end::shared_outline[]
+
+}
+
+#endif //BOOST_COBALT_MUTEX_HPP
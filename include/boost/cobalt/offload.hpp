@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_OFFLOAD_HPP
+#define BOOST_COBALT_OFFLOAD_HPP
+
+#include <boost/cobalt/detail/offload.hpp>
+
+#include <cstdint>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+// Run fn(args...) on the offload pool & resume on the executor of the awaiting coroutine.
+// If fn can be invoked with an offload_token as the first argument,
+// it gets passed one that reports if the awaiting coroutine got cancelled.
+template<typename Fn, typename ... Args>
+[[nodiscard]] auto offload(Fn && fn, Args && ... args)
+    -> detail::offload_op<std::decay_t<Fn>, std::decay_t<Args>...>;
+
+struct offload_stats
+{
+  // the size of the pool.
+  std::size_t threads;
+  // functions posted to the pool, that haven't started yet.
+  std::size_t queued;
+  // functions being executed.
+  std::size_t running;
+  // functions completed since the pool was started.
+  std::uint64_t completed;
+};
+
+BOOST_COBALT_DECL offload_stats get_offload_stats();
+
+// Set the amount of threads the pool gets started with. Defaults to std::thread::hardware_concurrency().
+// Returns false if the pool is already running, i.e. it needs to be set before the first offload.
+BOOST_COBALT_DECL bool set_offload_threads(std::size_t n);
+// end::outline[]
+
+template<typename Fn, typename ... Args>
+auto offload(Fn && fn, Args && ... args)
+    -> detail::offload_op<std::decay_t<Fn>, std::decay_t<Args>...>
+{
+  return {std::decay_t<Fn>(std::forward<Fn>(fn)),
+          std::tuple<std::decay_t<Args>...>(std::forward<Args>(args)...)};
+}
+
+}
+
+#endif //BOOST_COBALT_OFFLOAD_HPP
@@ -0,0 +1,41 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_PARALLEL_HPP
+#define BOOST_COBALT_PARALLEL_HPP
+
+#include <boost/cobalt/concepts.hpp>
+#include <boost/cobalt/detail/parallel.hpp>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+// Await fn(element) for every element of the range, with at most concurrency of them in flight.
+// The first error cancels the others & gets rethrown.
+template<typename Range, typename Fn>
+  requires awaitable<std::invoke_result_t<Fn&, decltype(*std::begin(std::declval<Range&>()))>>
+promise<void> parallel_for_each(Range && range, Fn fn, std::size_t concurrency)
+// end::outline[]
+{
+  return detail::parallel_impl<Range>(static_cast<Range&&>(range), std::move(fn),
+                                      detail::parallel_no_output{}, concurrency);
+}
+
+// tag::outline[]
+// Like parallel_for_each, but assigns the result of fn(range[i]) to out[i].
+template<typename Range, typename Fn, std::random_access_iterator OutputIterator>
+  requires awaitable<std::invoke_result_t<Fn&, decltype(*std::begin(std::declval<Range&>()))>>
+promise<void> parallel_transform(Range && range, Fn fn, OutputIterator out, std::size_t concurrency)
+// end::outline[]
+{
+  return detail::parallel_impl<Range>(static_cast<Range&&>(range), std::move(fn), std::move(out), concurrency);
+}
+
+}
+
+#endif //BOOST_COBALT_PARALLEL_HPP
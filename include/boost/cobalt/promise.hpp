@@ -78,6 +78,7 @@ struct [[nodiscard]] promise
     bool attached_;
 
     friend struct detached;
+    friend struct wait_group;
     //tag::outline[]
 };
 // end::outline[]
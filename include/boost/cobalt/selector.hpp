@@ -0,0 +1,264 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_SELECTOR_HPP
+#define BOOST_COBALT_SELECTOR_HPP
+
+#include <boost/cobalt/promise.hpp>
+#include <boost/cobalt/this_thread.hpp>
+#include <boost/cobalt/unique_handle.hpp>
+#include <boost/cobalt/detail/await_result_helper.hpp>
+#include <boost/cobalt/detail/util.hpp>
+
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/variant2/variant.hpp>
+
+#include <array>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+// A persistent race over a fixed set of sources.
+// Every source is a callable returning an awaitable, e.g. [&]{return chan.read();}.
+// Each source gets awaited until it produces a value, which is held until it gets selected.
+// Sources that didn't get selected keep their pending operation, only the selected one gets awaited again.
+template<typename ... Sources>
+  requires (sizeof...(Sources) > 0u)
+struct selector
+{
+  using result_type = variant2::variant<
+      detail::void_as_monostate<detail::co_await_result_t<std::invoke_result_t<Sources&>>>...>;
+
+  explicit selector(Sources ... sources);
+  // not movable, since the sources are running.
+  selector(selector && ) = delete;
+  // Cancels all pending sources.
+  ~selector();
+
+  // Cancel all pending sources. next() will throw after the values already produced have been consumed.
+  void close();
+
+  // end::outline[]
+ private:
+  struct state_;
+  struct next_op_;
+ public:
+  // tag::outline[]
+  // Await the next value. Ready sources are selected round robin, starting after the last selected one.
+  [[nodiscard]] next_op_ next();
+  auto operator co_await() {return next();}
+  // end::outline[]
+
+ private:
+  template<std::size_t Idx>
+  static promise<void> pump_(asio::executor_arg_t, executor, std::shared_ptr<state_> st);
+  template<std::size_t ... Idx>
+  void start_(std::index_sequence<Idx...>);
+
+  std::shared_ptr<state_> shared_state_;
+  std::array<std::optional<promise<void>>, sizeof...(Sources)> pumps_;
+  // tag::outline[]
+};
+// end::outline[]
+
+template<typename ... Sources>
+selector(Sources ...) -> selector<Sources...>;
+
+template<typename ... Sources>
+  requires (sizeof...(Sources) > 0u)
+struct selector<Sources...>::state_
+{
+  state_(executor exec, Sources ... sources) : exec(std::move(exec)), sources(std::move(sources)...) {}
+
+  executor exec;
+  std::tuple<Sources...> sources;
+  bool closed = false;
+  std::size_t next = 0u;
+
+  // a value or exception produced by a source, waiting to be selected.
+  std::array<std::optional<result_type>, sizeof...(Sources)> values;
+  std::array<std::exception_ptr, sizeof...(Sources)> errors;
+  // the pumps waiting for their value to be taken.
+  std::array<unique_handle<void>, sizeof...(Sources)> pumps;
+  // the coroutine awaiting next().
+  unique_handle<void> waiter{nullptr};
+
+  bool ready(std::size_t idx) const {return values[idx].has_value() || errors[idx] != nullptr;}
+
+  std::optional<std::size_t> find_ready() const
+  {
+    for (std::size_t i = 0u; i < sizeof...(Sources); i++)
+      if (const auto idx = (next + i) % sizeof...(Sources); ready(idx))
+        return idx;
+    return std::nullopt;
+  }
+
+  void notify()
+  {
+    if (waiter)
+      asio::post(exec, std::move(waiter));
+  }
+
+  // the pump is suspended until the value has been taken.
+  struct wait_taken
+  {
+    state_ & st;
+    std::size_t idx;
+    bool await_ready() const {return st.closed || !st.ready(idx);}
+    void await_suspend(std::coroutine_handle<void> h) {st.pumps[idx].reset(h.address());}
+    void await_resume() {}
+  };
+};
+
+template<typename ... Sources>
+  requires (sizeof...(Sources) > 0u)
+struct selector<Sources...>::next_op_
+{
+  std::shared_ptr<state_> st;
+  bool cancelled = false;
+  asio::cancellation_slot cancel_slot{};
+
+  struct cancel_impl
+  {
+    next_op_ * op;
+    cancel_impl(next_op_ * op) : op(op) {}
+    void operator()(asio::cancellation_type)
+    {
+      op->cancelled = true;
+      op->st->notify();
+      op->cancel_slot.clear();
+    }
+  };
+
+  bool await_ready() const {return st->find_ready().has_value() || st->closed;}
+
+  template<typename Promise>
+  void await_suspend(std::coroutine_handle<Promise> h)
+  {
+    if constexpr (requires {h.promise().get_cancellation_slot();})
+      if ((cancel_slot = h.promise().get_cancellation_slot()).is_connected())
+        cancel_slot.template emplace<cancel_impl>(this);
+    st->waiter.reset(h.address());
+  }
+
+  result_type await_resume()
+  {
+    cancel_slot.clear();
+    const auto idx = st->find_ready();
+    if (!idx)
+    {
+      constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION};
+      boost::throw_exception(system::system_error({asio::error::operation_aborted, &loc}, "selector"), loc);
+    }
+
+    auto & st_ = *st;
+    st_.next = (*idx + 1u) % sizeof...(Sources);
+    // rearm the source, i.e. let the pump await it again.
+    if (st_.pumps[*idx])
+      asio::post(st_.exec, std::move(st_.pumps[*idx]));
+
+    if (auto ep = std::exchange(st_.errors[*idx], nullptr))
+      std::rethrow_exception(ep);
+    auto res = std::move(*st_.values[*idx]);
+    st_.values[*idx].reset();
+    return res;
+  }
+};
+
+template<typename ... Sources>
+  requires (sizeof...(Sources) > 0u)
+selector<Sources...>::selector(Sources ... sources)
+    : shared_state_(std::make_shared<state_>(this_thread::get_executor(), std::move(sources)...))
+{
+}
+
+template<typename ... Sources>
+  requires (sizeof...(Sources) > 0u)
+selector<Sources...>::~selector()
+{
+  close();
+}
+
+template<typename ... Sources>
+  requires (sizeof...(Sources) > 0u)
+void selector<Sources...>::close()
+{
+  shared_state_->closed = true;
+  for (auto & p : pumps_)
+    if (p && !p->ready())
+      p->cancel();
+
+  for (auto & h : shared_state_->pumps)
+    if (h)
+      asio::post(shared_state_->exec, std::move(h));
+  shared_state_->notify();
+}
+
+template<typename ... Sources>
+  requires (sizeof...(Sources) > 0u)
+template<std::size_t Idx>
+promise<void> selector<Sources...>::pump_(asio::executor_arg_t, executor, std::shared_ptr<state_> st)
+{
+  co_await this_coro::throw_if_cancelled(false);
+  using result_t = detail::co_await_result_t<std::invoke_result_t<std::tuple_element_t<Idx, std::tuple<Sources...>>&>>;
+
+  while (!st->closed)
+  {
+    try
+    {
+      if constexpr (std::is_void_v<result_t>)
+      {
+        co_await std::get<Idx>(st->sources)();
+        st->values[Idx].emplace(variant2::in_place_index<Idx>);
+      }
+      else
+        st->values[Idx].emplace(variant2::in_place_index<Idx>, co_await std::get<Idx>(st->sources)());
+    }
+    catch (...)
+    {
+      if (st->closed)
+        break;
+      st->errors[Idx] = std::current_exception();
+    }
+
+    st->notify();
+    co_await typename state_::wait_taken{*st, Idx};
+  }
+}
+
+template<typename ... Sources>
+  requires (sizeof...(Sources) > 0u)
+template<std::size_t ... Idx>
+void selector<Sources...>::start_(std::index_sequence<Idx...>)
+{
+  (pumps_[Idx].emplace(pump_<Idx>(asio::executor_arg, shared_state_->exec, shared_state_)), ...);
+}
+
+template<typename ... Sources>
+  requires (sizeof...(Sources) > 0u)
+auto selector<Sources...>::next() -> next_op_
+{
+  // the sources only start getting awaited once the first value is requested.
+  if (!pumps_[0u] && !shared_state_->closed)
+    start_(std::make_index_sequence<sizeof...(Sources)>{});
+  return next_op_{shared_state_};
+}
+
+}
+
+#endif //BOOST_COBALT_SELECTOR_HPP
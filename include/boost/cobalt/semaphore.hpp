@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_SEMAPHORE_HPP
+#define BOOST_COBALT_SEMAPHORE_HPP
+
+#include <boost/cobalt/this_thread.hpp>
+#include <boost/cobalt/detail/sync_waiter.hpp>
+
+#include <tuple>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+struct semaphore
+{
+  explicit semaphore(std::size_t initial = 0u, executor exec = this_thread::get_executor())
+      : executor_(std::move(exec)), count_(initial) {}
+  // not movable.
+  semaphore(semaphore && rhs) noexcept = delete;
+  semaphore & operator=(semaphore && lhs) noexcept = delete;
+  // Destroys the waiting coroutines, like a channel.
+  BOOST_COBALT_DECL ~semaphore();
+
+  using executor_type = executor;
+  const executor_type & get_executor() {return executor_;}
+
+  // The amount of permits that can be acquired without waiting.
+  std::size_t available() const {return count_;}
+
+  // Take a permit if available without waiting.
+  BOOST_COBALT_DECL bool try_acquire();
+  // Return permits. They're handed to the waiting coroutines in FIFO order.
+  BOOST_COBALT_DECL void release(std::size_t n = 1u);
+
+  // end::outline[]
+ private:
+  struct acquire_op : detail::sync_waiter
+  {
+    semaphore * sem;
+
+    acquire_op(semaphore * sem, const boost::source_location & loc)
+        : detail::sync_waiter(sem->executor_, loc), sem(sem) {}
+
+    bool await_ready() const {return sem->count_ > 0u && sem->waiters_.empty();}
+
+    template<typename Promise>
+    BOOST_COBALT_MSVC_NOINLINE
+    std::coroutine_handle<void> await_suspend(std::coroutine_handle<Promise> h)
+    {
+      if (cancelled || await_ready())
+        return h; // interrupted or available.
+      enqueue(h, sem->waiters_);
+      return std::noop_coroutine();
+    }
+
+    BOOST_COBALT_DECL void await_resume();
+    BOOST_COBALT_DECL std::tuple<system::error_code> await_resume(const struct as_tuple_tag & );
+    BOOST_COBALT_DECL system::result<void> await_resume(const struct as_result_tag &);
+  };
+
+  executor_type executor_;
+  std::size_t count_;
+  detail::sync_waiter_queue waiters_;
+ public:
+  [[nodiscard]] acquire_op acquire(const boost::source_location & loc = BOOST_CURRENT_LOCATION) {return {this, loc};}
+  /*
+  // tag::outline[]
+  // an awaitable that yields void
+  using __acquire_op__ = __unspecified__;
+
+  // Wait for a permit.
+  __acquire_op__ acquire();
+  // end::outline[]
+   */
+  // tag::outline[]
+};
+// end::outline[]
+
+}
+
+#endif //BOOST_COBALT_SEMAPHORE_HPP
@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_SHARD_HPP
+#define BOOST_COBALT_SHARD_HPP
+
+#include <boost/cobalt/config.hpp>
+#include <boost/cobalt/task.hpp>
+
+#include <boost/asio/post.hpp>
+
+#include <functional>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+struct shard_options
+{
+  // The amount of shards, 0 means one per core.
+  std::size_t shards = 0u;
+  // Pin shard n to core n % cores. This is only supported on linux.
+  bool pin = true;
+  // Handle SIGINT & SIGTERM like co_main, by cancelling every shard.
+  bool handle_signals = true;
+};
+
+// A thread of a sharded runtime, with its own io_context & default memory resource.
+struct shard
+{
+  std::size_t index() const {return index_;}
+  std::size_t count() const {return executors_.size();}
+
+  // The executor of this shard.
+  const executor & get_executor() const {return executors_[index_];}
+  // The executor of another shard, e.g. to switch_to it.
+  const executor & get_executor(std::size_t idx) const {return executors_[idx];}
+
+  // Run fn on the thread of the shard idx.
+  template<typename Fn>
+  void post(std::size_t idx, Fn && fn) const
+  {
+    asio::post(executors_[idx], std::forward<Fn>(fn));
+  }
+
+  // Run a copy of fn on every shard, including this one.
+  template<typename Fn>
+  void broadcast(const Fn & fn) const
+  {
+    for (const auto & exec : executors_)
+      asio::post(exec, fn);
+  }
+  // end::outline[]
+
+  shard(std::size_t index, std::span<const executor> executors) : index_(index), executors_(executors) {}
+ private:
+  std::size_t index_;
+  std::span<const executor> executors_;
+  // tag::outline[]
+};
+// end::outline[]
+
+namespace detail
+{
+
+BOOST_COBALT_DECL int run_sharded(const shard_options & opts, void * fn, task<int> (*invoke)(void *, shard &));
+
+}
+
+// tag::outline[]
+// Start one thread per shard and run fn(shard&) on each of them, blocking until all of them are done.
+// fn gets invoked concurrently, once on every shard.
+// Returns the first non-zero result of any shard & rethrows the first exception.
+template<typename Fn>
+  requires std::is_invocable_r_v<task<int>, Fn&, shard&>
+int run_sharded(Fn && fn, const shard_options & opts = {})
+// end::outline[]
+{
+  return detail::run_sharded(
+      opts, const_cast<void*>(static_cast<const void*>(std::addressof(fn))),
+      +[](void * p, shard & s) -> task<int>
+      {
+        return std::invoke(*static_cast<std::remove_reference_t<Fn>*>(p), s);
+      });
+}
+
+}
+
+#endif //BOOST_COBALT_SHARD_HPP
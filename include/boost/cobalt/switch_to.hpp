@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_SWITCH_TO_HPP
+#define BOOST_COBALT_SWITCH_TO_HPP
+
+#include <boost/cobalt/config.hpp>
+#include <boost/cobalt/unique_handle.hpp>
+
+#include <boost/asio/execution/outstanding_work.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/prefer.hpp>
+
+#include <coroutine>
+#include <optional>
+
+namespace boost::cobalt
+{
+
+namespace detail
+{
+
+struct switch_to_op
+{
+  executor exec;
+  std::optional<executor> previous;
+
+  bool await_ready() const {return false;}
+
+  template<typename Promise>
+    requires requires (Promise & p, executor e) {p.set_executor(std::move(e));}
+  void await_suspend(std::coroutine_handle<Promise> h)
+  {
+    // tracked, so the previous context doesn't run out of work while the coroutine is away.
+    previous.emplace(asio::prefer(h.promise().get_executor(), asio::execution::outstanding_work.tracked));
+    h.promise().set_executor(exec);
+    asio::post(exec, unique_handle<void>(h.address()));
+  }
+
+  executor await_resume() {return std::move(*previous);}
+};
+
+}
+
+// tag::outline[]
+// Resume the current coroutine on exec & use it as the coroutine's executor from then on.
+// Returns the previous executor, which keeps tracking work, so the coroutine can switch back.
+[[nodiscard]] inline auto switch_to(executor exec) -> detail::switch_to_op
+// end::outline[]
+{
+  return detail::switch_to_op{std::move(exec)};
+}
+
+}
+
+#endif //BOOST_COBALT_SWITCH_TO_HPP
@@ -56,7 +56,7 @@ struct thread
   executor_type get_executor(const boost::source_location & loc = BOOST_CURRENT_LOCATION) const
   {
     auto st = state_;
-    if (!st || st->done)
+    if (!st || st->done())
       cobalt::detail::throw_bad_executor(loc);
 
     return st ->ctx.get_executor();
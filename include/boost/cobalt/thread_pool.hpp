@@ -0,0 +1,65 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_THREAD_POOL_HPP
+#define BOOST_COBALT_THREAD_POOL_HPP
+
+#include <boost/cobalt/detail/thread.hpp>
+#include <boost/cobalt/detail/thread_pool.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+// A set of warm threads, each with its own io_context & memory resource like a cobalt::thread.
+struct thread_pool
+{
+  // The options get applied to every thread, with the thread's index appended to the name.
+  BOOST_COBALT_DECL explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency(),
+                                         const thread_options & opts = {});
+  thread_pool(thread_pool && ) = delete;
+  // Stops the io_contexts & joins the threads.
+  BOOST_COBALT_DECL ~thread_pool();
+
+  std::size_t size() const {return workers_.size();}
+
+  // The executor of the next thread, round robin.
+  BOOST_COBALT_DECL executor get_executor();
+  // The executor of the thread idx.
+  BOOST_COBALT_DECL executor get_executor(std::size_t idx) const;
+
+  // Run the task returned by fn(args...) on one of the threads & complete with its result.
+  // fn gets invoked on the thread, so the task gets allocated from its memory resource.
+  // Cancellation gets forwarded to the task.
+  template<typename Fn, typename ... Args>
+    requires requires {typename detail::thread_pool_task<std::invoke_result_t<Fn, Args...>>::op_type;}
+  [[nodiscard]] auto run(Fn fn, Args ... args) -> detail::thread_pool_op<Fn, Args...>
+  {
+    return {get_executor(), std::move(fn), std::move(args)...};
+  }
+
+  // Stop the io_contexts, pending tasks won't complete.
+  BOOST_COBALT_DECL void stop();
+  // Wait for all tasks to complete & join the threads.
+  BOOST_COBALT_DECL void join();
+  // end::outline[]
+
+ private:
+  struct worker_;
+  std::vector<std::unique_ptr<worker_>> workers_;
+  std::atomic<std::size_t> next_{0u};
+  // tag::outline[]
+};
+// end::outline[]
+
+}
+
+#endif //BOOST_COBALT_THREAD_POOL_HPP
@@ -5,8 +5,21 @@
 #ifndef BOOST_COBALT_WAIT_GROUP_HPP
 #define BOOST_COBALT_WAIT_GROUP_HPP
 
+#include <boost/cobalt/result.hpp>
+#include <boost/cobalt/this_thread.hpp>
+#include <boost/cobalt/detail/sync_waiter.hpp>
 #include <boost/cobalt/detail/wait_group.hpp>
 
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
 namespace boost::cobalt
 {
 // tag::outline[]
@@ -17,11 +30,34 @@ struct wait_group
     wait_group(asio::cancellation_type normal_cancel = asio::cancellation_type::none,
                asio::cancellation_type exception_cancel = asio::cancellation_type::all);
 
-    // insert a task into the group
+    // create a wait_group that runs at most max_in_flight tasks started by admit or defer
+    // and queues up to max_queued deferred task factories.
+    explicit
+    wait_group(std::size_t max_in_flight, std::size_t max_queued = 0u,
+               asio::cancellation_type normal_cancel = asio::cancellation_type::none,
+               asio::cancellation_type exception_cancel = asio::cancellation_type::all,
+               executor exec = this_thread::get_executor());
+
+    // must not be moved while coroutines are waiting in admit.
+    wait_group(wait_group && lhs) noexcept;
+    wait_group& operator=(wait_group && lhs) noexcept;
+    // destroys the coroutines waiting in admit, like a channel.
+    ~wait_group();
+
+    // insert a task into the group. This ignores the limit, but counts towards it.
     void push_back(promise<void> p);
 
+    // start the task created by the factory if a slot is free,
+    // otherwise queue the factory to be started once one frees up.
+    // returns false if the queue is full. An exception of the factory gets rethrown by wait_one.
+    bool defer(std::function<promise<void>()> factory);
+
     // the number of tasks in the group
     std::size_t size() const;
+    // the number of running tasks
+    std::size_t in_flight() const;
+    // the number of deferred factories waiting for a slot
+    std::size_t queued() const;
     // remove completed tasks without waiting (i.e. zombie tasks)
     std::size_t reap();
     // cancel all tasks
@@ -40,36 +76,178 @@ struct wait_group
     // if `ep` is set, this will use the `exception_cancel` level,
     // otherwise the `normal_cancel` to cancel all promises.
     __wait_op__ await_exit(std::exception_ptr ep);
+    // wait for a free slot, then start the task created by the factory.
+    __admit_op__ admit(Factory factory);
      end::outline[] */
 
-    auto wait_one() -> detail::race_wrapper
+  private:
+    struct cancel_impl
     {
-        return  detail::race_wrapper(waitables_);
-    }
+        wait_group * wg;
+        cancel_impl(wait_group * wg) : wg(wg) {}
+        void operator()(asio::cancellation_type ct)
+        {
+            wg->cancel(ct);
+        }
+    };
+
+    template<bool All>
+    struct wait_op_
+    {
+        wait_group & wg;
+        asio::cancellation_slot cl{};
+
+        bool await_ready() const
+        {
+            if constexpr (All)
+                return wg.running_.empty();
+            else
+                return !wg.ready_.empty() || wg.running_.empty();
+        }
 
-    detail::gather_wrapper wait()
+        template<typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> h)
+        {
+            if (wg.waiter_)
+                boost::throw_exception(std::runtime_error("already-awaited"));
+
+            if constexpr (requires {h.promise().get_cancellation_slot();})
+                if ((cl = h.promise().get_cancellation_slot()).is_connected())
+                    cl.template emplace<cancel_impl>(&wg);
+            wg.wait_all_ = All;
+            wg.waiter_.reset(h.address());
+        }
+
+        // wait_one rethrows the exception of the completed task, wait swallows them.
+        void await_resume(const boost::source_location & loc = BOOST_CURRENT_LOCATION)
+        {
+            if (cl.is_connected())
+                cl.clear();
+            if constexpr (All)
+                wg.reap();
+            else if (auto ep = std::exchange(wg.admission_error_, nullptr))
+                std::rethrow_exception(ep);
+            else if (!wg.ready_.empty())
+                wg.take_ready_().get(loc);
+        }
+    };
+
+    template<typename Factory>
+    struct admit_op_ : detail::sync_waiter
     {
-        return detail::gather_wrapper(waitables_);
+        wait_group & wg;
+        Factory factory;
+
+        admit_op_(wait_group & wg, Factory && factory, const boost::source_location & loc)
+            : detail::sync_waiter(wg.exec_, loc), wg(wg), factory(std::move(factory)) {}
+
+        // the frame got destroyed after the slot was handed over, but before it resumed.
+        ~admit_op_()
+        {
+            if (direct && !resumed_)
+            {
+                wg.reserved_--;
+                wg.admit_();
+            }
+        }
+
+        bool await_ready() const {return wg.has_slot_();}
 
+        template<typename Promise>
+        BOOST_COBALT_MSVC_NOINLINE
+        std::coroutine_handle<void> await_suspend(std::coroutine_handle<Promise> h)
+        {
+            if (cancelled || await_ready())
+                return h; // interrupted or admitted.
+            enqueue(h, wg.admission_waiters_);
+            return std::noop_coroutine();
+        }
+
+        system::result<void> await_resume(const struct as_result_tag &)
+        {
+            resumed_ = true;
+            auto res = result();
+            if (!res)
+                return res;
+            // the slot was reserved when handing it over.
+            if (direct)
+                wg.reserved_--;
+            wg.push_back(std::invoke(factory));
+            return res;
+        }
+
+        void await_resume()
+        {
+            await_resume(as_result_tag{}).value(loc);
+        }
+
+        std::tuple<system::error_code> await_resume(const struct as_tuple_tag & )
+        {
+            return await_resume(as_result_tag{}).error();
+        }
+      private:
+        bool resumed_ = false;
+    };
+
+  public:
+    wait_op_<false> wait_one()
+    {
+        return wait_op_<false>{*this};
     }
-    detail::gather_wrapper::awaitable_type operator co_await ()
+
+    wait_op_<true> wait()
+    {
+        return wait_op_<true>{*this};
+    }
+    wait_op_<true> operator co_await ()
     {
-      return detail::gather_wrapper(waitables_).operator co_await();
+        return wait();
     }
     // swallow the exception here.
-    detail::gather_wrapper await_exit(std::exception_ptr ep)
+    wait_op_<true> await_exit(std::exception_ptr ep)
     {
         auto ct = ep ? ct_except_ : ct_normal_;
         if (ct != asio::cancellation_type::none)
-            for (auto & w : waitables_)
-                w.cancel(ct);
-        return detail::gather_wrapper(waitables_);
+            cancel(ct);
+        return wait();
+    }
+
+    template<typename Factory>
+      requires std::is_convertible_v<std::invoke_result_t<Factory&>, promise<void>>
+    [[nodiscard]] admit_op_<std::decay_t<Factory>> admit(Factory && factory,
+                                                        const boost::source_location & loc = BOOST_CURRENT_LOCATION)
+    {
+        return {*this, std::decay_t<Factory>(std::forward<Factory>(factory)), loc};
     }
 
 
   private:
-    std::list<promise<void>> waitables_;
+    detail::wait_group_node & allocate_node_();
+    void release_node_(detail::wait_group_node & nd);
+    promise<void> take_ready_();
+    static std::coroutine_handle<void> completed_(detail::promise_notification * pn);
+    bool has_slot_() const;
+    void start_deferred_(std::function<promise<void>()> & factory);
+    void admit_();
+
+    // declared before the lists, so the nodes get unlinked before destruction.
+    std::vector<detail::wait_group_slab> slabs_;
+    detail::wait_group_list running_, ready_, free_;
+    unique_handle<void> waiter_{nullptr};
+    bool wait_all_ = false;
     asio::cancellation_type ct_normal_, ct_except_;
+
+    // the admission control, i.e. the default wait_group is unlimited.
+    std::size_t max_in_flight_ = (std::numeric_limits<std::size_t>::max)();
+    std::size_t max_queued_ = 0u;
+    // slots handed to coroutines waiting in admit, that haven't resumed yet.
+    std::size_t reserved_ = 0u;
+    bool admitting_ = false;
+    executor exec_;
+    std::deque<std::function<promise<void>()>> deferred_;
+    detail::sync_waiter_queue admission_waiters_;
+    // an exception thrown by a deferred factory, rethrown from wait_one.
+    std::exception_ptr admission_error_;
   // tag::outline[]
 };
 // end::outline[]
@@ -79,25 +257,209 @@ inline wait_group::wait_group(
     asio::cancellation_type exception_cancel)
 : ct_normal_(normal_cancel), ct_except_(exception_cancel) {}
 
+inline wait_group::wait_group(
+    std::size_t max_in_flight, std::size_t max_queued,
+    asio::cancellation_type normal_cancel,
+    asio::cancellation_type exception_cancel,
+    executor exec)
+: ct_normal_(normal_cancel), ct_except_(exception_cancel),
+  max_in_flight_(max_in_flight), max_queued_(max_queued), exec_(std::move(exec))
+{
+    BOOST_ASSERT(max_in_flight > 0u);
+}
+
+inline wait_group::~wait_group()
+{
+    detail::destroy_waiters(admission_waiters_);
+}
+
+inline wait_group::wait_group(wait_group && lhs) noexcept
+    : slabs_(std::move(lhs.slabs_)),
+      running_(std::move(lhs.running_)), ready_(std::move(lhs.ready_)), free_(std::move(lhs.free_)),
+      waiter_(std::move(lhs.waiter_)), wait_all_(lhs.wait_all_),
+      ct_normal_(lhs.ct_normal_), ct_except_(lhs.ct_except_),
+      max_in_flight_(lhs.max_in_flight_), max_queued_(lhs.max_queued_), reserved_(lhs.reserved_),
+      exec_(std::move(lhs.exec_)), deferred_(std::move(lhs.deferred_)),
+      admission_error_(std::move(lhs.admission_error_))
+{
+    BOOST_ASSERT(lhs.admission_waiters_.empty());
+    for (auto & nd : running_)
+        nd.group = this;
+}
+
+inline wait_group& wait_group::operator=(wait_group && lhs) noexcept
+{
+    running_.clear();
+    ready_.clear();
+    free_.clear();
+    // destroys the promises, i.e. cancels the running ones.
+    slabs_ = std::move(lhs.slabs_);
+    running_ = std::move(lhs.running_);
+    ready_ = std::move(lhs.ready_);
+    free_ = std::move(lhs.free_);
+    waiter_ = std::move(lhs.waiter_);
+    wait_all_ = lhs.wait_all_;
+    ct_normal_ = lhs.ct_normal_;
+    ct_except_ = lhs.ct_except_;
+    BOOST_ASSERT(admission_waiters_.empty() && lhs.admission_waiters_.empty());
+    max_in_flight_ = lhs.max_in_flight_;
+    max_queued_ = lhs.max_queued_;
+    reserved_ = lhs.reserved_;
+    exec_ = std::move(lhs.exec_);
+    deferred_ = std::move(lhs.deferred_);
+    admission_error_ = std::move(lhs.admission_error_);
+    for (auto & nd : running_)
+        nd.group = this;
+    return *this;
+}
+
+inline
+std::size_t wait_group::size() const {return running_.size() + ready_.size();}
+
+inline
+std::size_t wait_group::in_flight() const {return running_.size();}
+
+inline
+std::size_t wait_group::queued() const {return deferred_.size();}
+
+inline
+bool wait_group::defer(std::function<promise<void>()> factory)
+{
+  if (has_slot_())
+    start_deferred_(factory);
+  else if (deferred_.size() < max_queued_)
+    deferred_.push_back(std::move(factory));
+  else
+    return false;
+  return true;
+}
+
 inline
-std::size_t wait_group::size() const {return waitables_.size();}
+bool wait_group::has_slot_() const
+{
+  return running_.size() + reserved_ < max_in_flight_
+      && deferred_.empty() && admission_waiters_.empty();
+}
+
+// The exception of a factory gets rethrown by wait_one, whether it got started by defer or later.
+inline
+void wait_group::start_deferred_(std::function<promise<void>()> & factory)
+{
+  try
+  {
+    push_back(factory());
+  }
+  catch (...)
+  {
+    if (!admission_error_)
+      admission_error_ = std::current_exception();
+  }
+}
+
+// Hand out the free slots, deferred factories first.
+inline
+void wait_group::admit_()
+{
+  if (admitting_)
+    return;
+  admitting_ = true;
+  while (running_.size() + reserved_ < max_in_flight_)
+  {
+    if (!deferred_.empty())
+    {
+      auto factory = std::move(deferred_.front());
+      deferred_.pop_front();
+      start_deferred_(factory);
+    }
+    else if (!admission_waiters_.empty())
+    {
+      reserved_++;
+      admission_waiters_.front().complete();
+    }
+    else
+      break;
+  }
+  admitting_ = false;
+}
 
 inline
 std::size_t wait_group::reap()
 {
-  return erase_if(waitables_, [](promise<void> & p) { return p.ready() && p;});
+  const auto n = ready_.size();
+  while (!ready_.empty())
+    release_node_(ready_.front());
+  return n;
 }
 
 inline
 void wait_group::cancel(asio::cancellation_type ct)
 {
-  for (auto & w : waitables_)
-    w.cancel(ct);
+  // a task might complete during the cancellation.
+  for (auto itr = running_.begin(); itr != running_.end(); )
+    (itr++)->promise_->cancel(ct);
 }
 
 inline
-void wait_group::push_back(promise<void> p) { waitables_.push_back(std::move(p));}
+void wait_group::push_back(promise<void> p)
+{
+  auto & nd = allocate_node_();
+  auto & pr = nd.promise_.emplace(std::move(p));
+  if (pr.ready())
+    ready_.push_back(nd);
+  else
+  {
+    nd.group = this;
+    nd.completed = &completed_;
+    pr.receiver_.notification = &nd;
+    running_.push_back(nd);
+  }
+}
 
+inline
+detail::wait_group_node & wait_group::allocate_node_()
+{
+  if (free_.empty())
+  {
+    // grows geometrically up to 4096 nodes per slab.
+    const std::size_t n = std::size_t(16u) << (std::min)(slabs_.size(), std::size_t(8u));
+    auto & slab = slabs_.emplace_back(std::make_unique<detail::wait_group_node[]>(n));
+    for (std::size_t i = 0u; i < n; i++)
+      free_.push_back(slab[i]);
+  }
+  auto & nd = free_.front();
+  free_.pop_front();
+  return nd;
+}
+
+inline
+void wait_group::release_node_(detail::wait_group_node & nd)
+{
+  ready_.erase(ready_.iterator_to(nd));
+  nd.promise_.reset();
+  free_.push_front(nd);
+}
+
+inline
+promise<void> wait_group::take_ready_()
+{
+  auto & nd = ready_.front();
+  auto p = std::move(*nd.promise_);
+  release_node_(nd);
+  return p;
+}
+
+inline
+std::coroutine_handle<void> wait_group::completed_(detail::promise_notification * pn)
+{
+  auto & nd = static_cast<detail::wait_group_node&>(*pn);
+  auto & wg = *nd.group;
+  wg.running_.erase(wg.running_.iterator_to(nd));
+  wg.ready_.push_back(nd);
+  wg.admit_();
+  if (wg.waiter_ && (!wg.wait_all_ || wg.running_.empty()))
+    return wg.waiter_.release();
+  return std::noop_coroutine();
+}
 
 }
 
@@ -0,0 +1,39 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_WHEN_K_HPP
+#define BOOST_COBALT_WHEN_K_HPP
+
+#include <boost/cobalt/concepts.hpp>
+#include <boost/cobalt/detail/when_k.hpp>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+// Complete once k awaitables succeeded, interrupting the rest.
+// Returns a tuple of optionals, where exactly k are set.
+template<awaitable ... Promise>
+auto when_k(std::size_t k, Promise && ... p)
+// end::outline[]
+{
+  return detail::when_k_variadic_impl<Promise ...>(k, static_cast<Promise&&>(p)...);
+}
+
+// tag::outline[]
+// Returns the index & result of the first k successful awaitables, in the order they completed.
+template<typename PromiseRange>
+  requires awaitable<std::decay_t<decltype(*std::declval<PromiseRange>().begin())>>
+auto when_k(std::size_t k, PromiseRange && p)
+// end::outline[]
+{
+  return detail::when_k_ranged_impl<PromiseRange>{k, static_cast<PromiseRange&&>(p)};
+}
+
+}
+
+#endif //BOOST_COBALT_WHEN_K_HPP
@@ -0,0 +1,29 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_COBALT_WITH_TIMEOUT_HPP
+#define BOOST_COBALT_WITH_TIMEOUT_HPP
+
+#include <boost/cobalt/concepts.hpp>
+#include <boost/cobalt/detail/with_timeout.hpp>
+
+namespace boost::cobalt
+{
+
+// tag::outline[]
+// Await aw, cancelling it if it didn't complete after the timeout.
+// Returns a system::result, with asio::error::timed_out if the timeout expired.
+template<awaitable Awaitable>
+auto with_timeout(Awaitable && aw, std::chrono::steady_clock::duration timeout)
+// end::outline[]
+{
+  return detail::with_timeout_impl<Awaitable>(static_cast<Awaitable&&>(aw), timeout);
+}
+
+}
+
+#endif //BOOST_COBALT_WITH_TIMEOUT_HPP
@@ -0,0 +1,33 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/barrier.hpp>
+
+namespace boost::cobalt
+{
+
+barrier::~barrier()
+{
+  detail::destroy_waiters(waiters_);
+}
+
+void barrier::arrive_and_drop()
+{
+  BOOST_ASSERT(expected_ > 0u);
+  expected_--;
+  if (arrived_ > 0u && arrived_ >= expected_)
+    complete_phase_();
+}
+
+void barrier::complete_phase_()
+{
+  arrived_ = 0u;
+  phase_++;
+  detail::complete_all(waiters_, executor_);
+}
+
+}
@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/detail/with_timeout.hpp>
+
+#include <boost/asio/basic_waitable_timer.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/post.hpp>
+
+#include <atomic>
+#include <optional>
+
+namespace boost::cobalt::detail
+{
+
+// One timer per execution context, armed for the earliest deadline.
+// It's not synchronized, i.e. the execution context must only be run by one thread,
+// as is the case for the contexts of cobalt::main, cobalt::thread & the likes.
+struct deadline_service final : asio::detail::execution_context_service_base<deadline_service>
+{
+  deadline_service(asio::execution_context & ctx)
+      : asio::detail::execution_context_service_base<deadline_service>(ctx)
+  {
+  }
+
+  ~deadline_service();
+  void shutdown() override;
+
+  void add(const executor & exec, deadline_node & nd)
+  {
+    if (!timer_)
+      timer_.emplace(exec);
+
+    // timeouts mostly share the same duration, so the new deadline usually goes to the back.
+    auto p = tail_;
+    while (p != nullptr && p->expiry > nd.expiry)
+      p = p->prev;
+
+    nd.prev = p;
+    nd.next = p ? p->next : head_;
+    (nd.next ? nd.next->prev : tail_) = &nd;
+    (p ? p->next : head_) = &nd;
+    nd.service = this;
+    nd.expired = false;
+
+    if (!armed_ || nd.expiry < armed_at_)
+      arm_(nd.expiry);
+  }
+
+  // The timer stays armed, it'll re-arm for the next deadline when it fires.
+  // If the list is empty it gets cancelled, because the pending wait keeps run() from returning.
+  void remove(deadline_node & nd)
+  {
+    (nd.prev ? nd.prev->next : head_) = nd.next;
+    (nd.next ? nd.next->prev : tail_) = nd.prev;
+    nd.prev = nd.next = nullptr;
+    nd.service = nullptr;
+
+    if (head_ == nullptr && armed_ && !idle_check_)
+    {
+      // deferred, since the next with_timeout usually gets added right away, e.g. in a read loop.
+      idle_check_ = true;
+      asio::post(timer_->get_executor(),
+                 [this]
+                 {
+                   idle_check_ = false;
+                   if (head_ == nullptr && armed_)
+                   {
+                     armed_ = false;
+                     timer_->cancel();
+                   }
+                 });
+    }
+  }
+
+ private:
+  void arm_(std::chrono::steady_clock::time_point tp)
+  {
+    armed_ = true;
+    armed_at_ = tp;
+    timer_->expires_at(tp);
+    timer_->async_wait(
+        [this](system::error_code ec)
+        {
+          if (ec != asio::error::operation_aborted)
+            expire_();
+        });
+  }
+
+  void expire_()
+  {
+    armed_ = false;
+    const auto now = std::chrono::steady_clock::now();
+    while (head_ != nullptr && head_->expiry <= now)
+    {
+      auto & nd = *head_;
+      remove(nd);
+      nd.expired = true;
+      nd.signal.emit(asio::cancellation_type::all);
+    }
+    if (head_ != nullptr)
+      arm_(head_->expiry);
+  }
+
+  std::optional<asio::basic_waitable_timer<std::chrono::steady_clock,
+                                           asio::wait_traits<std::chrono::steady_clock>,
+                                           executor>> timer_;
+  bool armed_ = false;
+  bool idle_check_ = false;
+  std::chrono::steady_clock::time_point armed_at_;
+  deadline_node * head_ = nullptr;
+  deadline_node * tail_ = nullptr;
+};
+
+namespace
+{
+
+// bumped when a service goes away, so the per thread caches can't match a new context at the same address.
+std::atomic<std::size_t> service_epoch{0u};
+
+struct service_cache
+{
+  asio::execution_context * ctx = nullptr;
+  deadline_service * service = nullptr;
+  std::size_t epoch = 0u;
+};
+
+// avoids the locked lookup of the service on every call.
+thread_local service_cache last_service;
+
+}
+
+deadline_service::~deadline_service()
+{
+  service_epoch.fetch_add(1u, std::memory_order_release);
+}
+
+void deadline_service::shutdown()
+{
+  armed_ = false;
+  while (head_ != nullptr)
+    remove(*head_);
+  timer_.reset();
+}
+
+void add_deadline(const executor & exec, deadline_node & node)
+{
+  auto & ctx = asio::query(exec, asio::execution::context);
+  const auto epoch = service_epoch.load(std::memory_order_acquire);
+  auto & c = last_service;
+  if (c.ctx != &ctx || c.epoch != epoch || c.service == nullptr)
+    c = {&ctx, &asio::use_service<deadline_service>(ctx), epoch};
+  c.service->add(exec, node);
+}
+
+void remove_deadline(deadline_node & node)
+{
+  if (node.service != nullptr)
+    node.service->remove(node);
+}
+
+}
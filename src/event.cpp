@@ -0,0 +1,51 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/event.hpp>
+#include <boost/cobalt/result.hpp>
+
+namespace boost::cobalt
+{
+
+event::~event()
+{
+  detail::destroy_waiters(waiters_);
+}
+
+void event::set()
+{
+  if (mode_ == manual_reset)
+  {
+    set_ = true;
+    detail::complete_all(waiters_, executor_);
+  }
+  else if (!waiters_.empty())
+    waiters_.front().complete();
+  else
+    set_ = true;
+}
+
+system::result<void> event::wait_op::await_resume(const struct as_result_tag &)
+{
+  auto res = result();
+  // an auto reset event that was set without waiters gets consumed.
+  if (res && !direct && evt->mode_ == auto_reset)
+    evt->set_ = false;
+  return res;
+}
+
+void event::wait_op::await_resume()
+{
+  await_resume(as_result_tag{}).value(loc);
+}
+
+std::tuple<system::error_code> event::wait_op::await_resume(const struct as_tuple_tag & )
+{
+  return await_resume(as_result_tag{}).error();
+}
+
+}
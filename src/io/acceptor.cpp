@@ -8,6 +8,8 @@
 #include <boost/cobalt/io/acceptor.hpp>
 #include <boost/cobalt/composition.hpp>
 
+#include <boost/asio/detail/socket_option.hpp>
+
 namespace boost::cobalt::io
 {
 
@@ -32,6 +34,30 @@ endpoint acceptor::local_endpoint()
   return acceptor_.local_endpoint();
 }
 
+system::result<acceptor> acceptor::reuse_port(endpoint ep, int backlog, const cobalt::executor & exec)
+{
+#if defined(SO_REUSEPORT)
+  acceptor acc{exec};
+  system::error_code ec;
+  acc.acceptor_.open(ep.protocol(), ec);
+  if (!ec)
+    acc.acceptor_.set_option(asio::socket_base::reuse_address(true), ec);
+  if (!ec)
+    acc.acceptor_.set_option(
+        asio::detail::socket_option::boolean<BOOST_ASIO_OS_DEF(SOL_SOCKET), SO_REUSEPORT>(true), ec);
+  if (!ec)
+    acc.acceptor_.bind(ep, ec);
+  if (!ec)
+    acc.acceptor_.listen(backlog, ec);
+  if (ec)
+    return ec;
+  return acc;
+#else
+  constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION};
+  return {system::in_place_error, asio::error::operation_not_supported, &loc};
+#endif
+}
+
 void acceptor::accept_op::initiate (boost::cobalt::completion_handler<system::error_code> handler)
 {
   acceptor_.async_accept(sock_.socket_, std::move(handler));
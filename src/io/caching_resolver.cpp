@@ -0,0 +1,308 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/io/caching_resolver.hpp>
+#include <boost/cobalt/result.hpp>
+
+#include <boost/asio/append.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/post.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <list>
+#include <vector>
+
+#if defined(BOOST_ASIO_WINDOWS)
+#include <winsock2.h>
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#endif
+
+namespace boost::cobalt::io
+{
+
+struct caching_resolver::entry_
+{
+  entry_(std::string_view host, std::string_view service) : host(host), service(service) {}
+
+  std::string host;
+  std::string service;
+
+  bool pending = true;
+  std::chrono::steady_clock::time_point expiry;
+  system::error_code error;
+  endpoint_sequence results;
+
+  std::list<completion_handler<system::error_code, endpoint_sequence>> waiters;
+  std::optional<promise<void>> lookup;
+
+  bool expired(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const
+  {
+    return !pending && expiry <= now;
+  }
+
+  void complete_waiters()
+  {
+    while (!waiters.empty())
+    {
+      auto h = std::move(waiters.front());
+      waiters.pop_front();
+      h.get_cancellation_slot().clear();
+      asio::post(asio::append(std::move(h), error, copy_results()));
+    }
+  }
+
+  endpoint_sequence copy_results() const
+  {
+#if !defined(BOOST_COBALT_NO_PMR)
+    return endpoint_sequence(results, this_thread::get_allocator());
+#else
+    return results;
+#endif
+  }
+};
+
+namespace
+{
+
+void set_port(endpoint & ep, std::uint16_t port)
+{
+  const auto family = ep.protocol().family();
+  if (family == BOOST_ASIO_OS_DEF(AF_INET))
+    static_cast<asio::detail::sockaddr_in4_type*>(ep.data())->sin_port = boost::endian::native_to_big(port);
+  else if (family == BOOST_ASIO_OS_DEF(AF_INET6))
+    static_cast<asio::detail::sockaddr_in6_type*>(ep.data())->sin6_port = boost::endian::native_to_big(port);
+}
+
+}
+
+caching_resolver::caching_resolver(const cobalt::executor & exec)
+    : executor_(exec), system_backend_(std::in_place, exec), backend_(*system_backend_)
+{
+}
+
+caching_resolver::caching_resolver(resolver_backend & backend, const cobalt::executor & exec)
+    : executor_(exec), backend_(backend)
+{
+}
+
+caching_resolver::~caching_resolver()
+{
+  for (auto & [_, e] : cache_)
+    if (e->pending)
+    {
+      e->error = asio::error::operation_aborted;
+      e->complete_waiters();
+      // cancels the lookup, which will keep the entry alive until it's done.
+      e->lookup.reset();
+    }
+}
+
+system::result<void> caching_resolver::add_host(std::string_view host, std::string_view address)
+{
+  system::error_code ec;
+  if (address.size() <= 45u)
+  {
+    const boost::static_string<46> addr{address.begin(), address.end()};
+    asio::ip::make_address(addr.c_str(), ec);
+  }
+
+  if (address.size() > 45u || ec)
+  {
+    constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION};
+    return {system::in_place_error, asio::error::invalid_argument, &loc};
+  }
+
+  auto itr = hosts_.find(host);
+  if (itr == hosts_.end())
+    itr = hosts_.emplace(std::string(host), endpoint_sequence{}).first;
+
+  itr->second.emplace_back(io::ip, address, static_cast<std::uint16_t>(0u));
+  return system::in_place_value;
+}
+
+system::result<void> caching_resolver::load_hosts(std::string_view content)
+{
+  constexpr std::string_view whitespace = " \t\r";
+  while (!content.empty())
+  {
+    auto line = content.substr(0u, content.find('\n'));
+    content.remove_prefix((std::min)(line.size() + 1u, content.size()));
+
+    line = line.substr(0u, line.find('#'));
+
+    auto next_token = [&]
+    {
+      const auto start = (std::min)(line.find_first_not_of(whitespace), line.size());
+      line.remove_prefix(start);
+      auto token = line.substr(0u, line.find_first_of(whitespace));
+      line.remove_prefix(token.size());
+      return token;
+    };
+
+    const auto address = next_token();
+    if (address.empty())
+      continue;
+
+    for (auto host = next_token(); !host.empty(); host = next_token())
+    {
+      auto res = add_host(host, address);
+      if (res.has_error())
+        return res;
+    }
+  }
+  return system::in_place_value;
+}
+
+void caching_resolver::erase(std::string_view host, std::string_view service)
+{
+  auto itr = cache_.find(std::pair(host, service));
+  if (itr != cache_.end() && !itr->second->pending)
+    cache_.erase(itr);
+}
+
+void caching_resolver::clear()
+{
+  std::erase_if(cache_, [](auto & kv) {return !kv.second->pending;});
+}
+
+void caching_resolver::purge_()
+{
+  const auto now = std::chrono::steady_clock::now();
+  std::erase_if(cache_, [&](auto & kv) {return kv.second->expired(now);});
+  if (cache_.size() < max_entries)
+    return;
+
+  // still full of live entries, so evict the oldest ones, i.e. the ones expiring first.
+  // an eighth more than needed, so that a burst of new hosts doesn't do this on every lookup.
+  const auto target = max_entries - (std::min)(max_entries, max_entries / 8u + 1u);
+  std::vector<decltype(cache_)::iterator> completed;
+  for (auto itr = cache_.begin(); itr != cache_.end(); itr++)
+    if (!itr->second->pending) // pending lookups have waiters, so they need to stay.
+      completed.push_back(itr);
+
+  const auto n = (std::min)(completed.size(), cache_.size() - target);
+  std::nth_element(completed.begin(), completed.begin() + n, completed.end(),
+                   [](auto lhs, auto rhs) {return lhs->second->expiry < rhs->second->expiry;});
+  for (std::size_t i = 0u; i < n; i++)
+    cache_.erase(completed[i]);
+}
+
+promise<void> caching_resolver::lookup_(asio::executor_arg_t, executor, resolver_backend & backend,
+                                        std::shared_ptr<entry_> e,
+                                        std::chrono::steady_clock::duration ttl,
+                                        std::chrono::steady_clock::duration negative_ttl)
+{
+  auto [ec, results] = co_await as_tuple(backend.resolve(e->host, e->service));
+
+  e->pending = false;
+  e->error = ec;
+  e->results = std::move(results);
+  const auto now = std::chrono::steady_clock::now();
+  if (ec == asio::error::operation_aborted) // don't cache cancellations
+    e->expiry = now;
+  else
+    e->expiry = now + (ec ? negative_ttl : ttl);
+
+  e->complete_waiters();
+}
+
+namespace
+{
+
+// A port number or a name from the services database, e.g. "http".
+bool parse_service(std::string_view service, std::uint16_t & port)
+{
+  auto [ptr, ec] = std::from_chars(service.data(), service.data() + service.size(), port);
+  if (ec == std::errc{} && ptr == service.data() + service.size())
+    return true;
+
+  const std::string name(service);
+#if defined(__GLIBC__)
+  servent se, * res = nullptr;
+  char buf[1024];
+  if (::getservbyname_r(name.c_str(), nullptr, &se, buf, sizeof(buf), &res) != 0 || res == nullptr)
+    return false;
+#else
+  const auto res = ::getservbyname(name.c_str(), nullptr);
+  if (res == nullptr)
+    return false;
+#endif
+  port = ntohs(static_cast<std::uint16_t>(res->s_port));
+  return true;
+}
+
+}
+
+void caching_resolver::resolve_op_::ready(handler<system::error_code, endpoint_sequence> h)
+{
+  if (auto itr = resolver_.hosts_.find(host_); itr != resolver_.hosts_.end())
+  {
+    std::uint16_t port = 0u;
+    if (!service_.empty() && !parse_service(service_, port))
+      return h(asio::error::service_not_found, endpoint_sequence{});
+
+#if !defined(BOOST_COBALT_NO_PMR)
+    endpoint_sequence res(itr->second, this_thread::get_allocator());
+#else
+    endpoint_sequence res(itr->second);
+#endif
+    for (auto & ep : res)
+      set_port(ep, port);
+    return h({}, std::move(res));
+  }
+
+  auto itr = resolver_.cache_.find(std::pair(host_, service_));
+  if (itr != resolver_.cache_.end() && !itr->second->pending && !itr->second->expired())
+    h(itr->second->error, itr->second->copy_results());
+}
+
+void caching_resolver::resolve_op_::initiate(completion_handler<system::error_code, endpoint_sequence> h)
+{
+  auto & r = resolver_;
+  auto itr = r.cache_.find(std::pair(host_, service_));
+  if (itr != r.cache_.end() && itr->second->expired())
+  {
+    r.cache_.erase(itr);
+    itr = r.cache_.end();
+  }
+
+  if (itr != r.cache_.end() && !itr->second->pending) // ready picks this up usually
+  {
+    auto & e = *itr->second;
+    return h(e.error, e.copy_results());
+  }
+
+  const bool start = itr == r.cache_.end();
+  if (start)
+  {
+    if (r.cache_.size() >= r.max_entries)
+      r.purge_();
+    itr = r.cache_.emplace(std::pair(std::string(host_), std::string(service_)),
+                           std::make_shared<entry_>(host_, service_)).first;
+  }
+
+  auto & e = *itr->second;
+  auto & w = e.waiters.emplace_back(std::move(h));
+  if (auto slot = w.get_cancellation_slot(); slot.is_connected())
+    slot.assign(
+        [ep = &e, wtr = std::prev(e.waiters.end())](asio::cancellation_type)
+        {
+          // the lookup keeps going, so the other waiters & the cache still get the result.
+          auto h = std::move(*wtr);
+          ep->waiters.erase(wtr);
+          asio::post(asio::append(std::move(h), asio::error::operation_aborted, endpoint_sequence{}));
+        });
+
+  // added the waiter first, in case the backend completes immediately.
+  if (start)
+    e.lookup.emplace(lookup_(asio::executor_arg, r.executor_, r.backend_, itr->second, r.ttl, r.negative_ttl));
+}
+
+}
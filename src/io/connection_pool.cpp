@@ -0,0 +1,300 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/io/connection_pool.hpp>
+#include <boost/cobalt/io/stream_socket.hpp>
+#include <boost/cobalt/composition.hpp>
+
+#include <boost/asio/append.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/assert.hpp>
+
+#include <deque>
+#include <list>
+
+#if defined(BOOST_ASIO_WINDOWS)
+#include <winsock2.h>
+#else
+#include <poll.h>
+#endif
+
+namespace boost::cobalt::io
+{
+
+struct connection_pool::key_entry_
+{
+  struct idle_connection
+  {
+    std::unique_ptr<stream> conn;
+    std::chrono::steady_clock::time_point since;
+  };
+
+  // the most recently returned connection is at the back.
+  std::deque<idle_connection> idle;
+  // idle, leased & connecting.
+  std::size_t total = 0u;
+  std::list<completion_handler<system::error_code, lease>> waiters;
+};
+
+namespace
+{
+
+// An idle connection should have nothing to read. If it's readable, the peer either closed it,
+// or sent something like a tls session ticket, which is fine.
+bool is_alive(stream & s)
+{
+  auto sock = dynamic_cast<io::socket*>(&s);
+  if (sock == nullptr)
+    return true;
+  if (!sock->is_open())
+    return false;
+
+#if defined(BOOST_ASIO_WINDOWS)
+  WSAPOLLFD pfd{sock->native_handle(), POLLRDNORM, 0};
+  const int readable = ::WSAPoll(&pfd, 1, 0);
+#else
+  pollfd pfd{sock->native_handle(), POLLIN, 0};
+  const int readable = ::poll(&pfd, 1, 0);
+#endif
+  if (readable < 0)
+    return false;
+  if (readable == 0)
+    return true;
+
+  auto n = sock->bytes_readable();
+  return n.has_value() && *n > 0u;
+}
+
+}
+
+tcp_connector::tcp_connector(const cobalt::executor & exec) : executor_(exec) {}
+
+void tcp_connector::initiate_connect_(void * this_, endpoint ep,
+                                      completion_handler<system::error_code, std::unique_ptr<stream>>)
+{
+  auto & self = *static_cast<tcp_connector*>(this_);
+  auto s = std::make_unique<stream_socket>(self.executor_);
+  auto [ec] = co_await s->connect(ep);
+  if (ec)
+    co_return {ec, nullptr};
+  co_return {ec, std::unique_ptr<stream>(std::move(s))};
+}
+
+connection_pool::connection_pool(const cobalt::executor & exec) : tcp_(exec) {}
+
+connection_pool::~connection_pool()
+{
+  // a connecting acquire holds references to the pool & its entry.
+  BOOST_ASSERT(connecting_ == 0u);
+  for (auto & [_, e] : entries_)
+    while (!e->waiters.empty())
+    {
+      auto h = std::move(e->waiters.front());
+      e->waiters.pop_front();
+      h.get_cancellation_slot().clear();
+      asio::post(asio::append(std::move(h), asio::error::operation_aborted, lease{}));
+    }
+}
+
+connection_pool::lease::lease(connection_pool & pool, key_entry_ & entry, std::unique_ptr<stream> s, bool reused)
+    : pool_(&pool), entry_(&entry), stream_(std::move(s)),
+      socket_(dynamic_cast<io::socket*>(stream_.get())), reused_(reused)
+{
+}
+
+connection_pool::lease::lease(lease && lhs) noexcept
+    : pool_(std::exchange(lhs.pool_, nullptr)), entry_(std::exchange(lhs.entry_, nullptr)),
+      stream_(std::move(lhs.stream_)), socket_(std::exchange(lhs.socket_, nullptr)),
+      reused_(lhs.reused_), discard_(lhs.discard_)
+{
+}
+
+connection_pool::lease& connection_pool::lease::operator=(lease && lhs) noexcept
+{
+  if (this != &lhs)
+  {
+    release();
+    pool_    = std::exchange(lhs.pool_, nullptr);
+    entry_   = std::exchange(lhs.entry_, nullptr);
+    stream_  = std::move(lhs.stream_);
+    socket_  = std::exchange(lhs.socket_, nullptr);
+    reused_  = lhs.reused_;
+    discard_ = lhs.discard_;
+  }
+  return *this;
+}
+
+connection_pool::lease::~lease()
+{
+  release();
+}
+
+void connection_pool::lease::release()
+{
+  if (auto p = std::exchange(pool_, nullptr))
+  {
+    socket_ = nullptr;
+    p->return_(*std::exchange(entry_, nullptr), std::move(stream_), discard_);
+  }
+}
+
+connection_pool::key_entry_ & connection_pool::entry_for_(const endpoint & ep, connector & con)
+{
+  // the endpoint might not be fully specified yet, e.g. if it comes from a lookup.
+  auto adopted = ep;
+  if (adopted.protocol().type() == 0)
+    adopted.set_type(BOOST_ASIO_OS_DEF(SOCK_STREAM));
+
+  std::string key;
+  const auto append = [&](const void * data, std::size_t size) {key.append(static_cast<const char*>(data), size);};
+  const connector * cp = &con;
+  append(&cp, sizeof(cp));
+  const int type = adopted.protocol().type();
+  append(&type, sizeof(type));
+  append(adopted.data(), adopted.size());
+
+  auto itr = entries_.find(key);
+  if (itr == entries_.end())
+    itr = entries_.emplace(std::move(key), std::make_unique<key_entry_>()).first;
+  return *itr->second;
+}
+
+connection_pool::lease connection_pool::pop_idle_(key_entry_ & e)
+{
+  const auto now = std::chrono::steady_clock::now();
+  while (!e.idle.empty())
+  {
+    auto ic = std::move(e.idle.back());
+    e.idle.pop_back();
+    if (now - ic.since < idle_timeout && is_alive(*ic.conn))
+      return lease{*this, e, std::move(ic.conn), true};
+    e.total--;
+  }
+  return {};
+}
+
+void connection_pool::return_(key_entry_ & e, std::unique_ptr<stream> s, bool discard)
+{
+  if (s && !discard)
+    if (auto sock = dynamic_cast<io::socket*>(s.get()); sock != nullptr && !sock->is_open())
+      discard = true;
+  if (discard)
+    s.reset();
+
+  // hand over the connection or the slot to the longest waiter.
+  if (!e.waiters.empty())
+  {
+    auto h = std::move(e.waiters.front());
+    e.waiters.pop_front();
+    h.get_cancellation_slot().clear();
+    const bool reused = s != nullptr;
+    asio::post(asio::append(std::move(h), system::error_code{}, lease{*this, e, std::move(s), reused}));
+    return;
+  }
+
+  if (s && e.idle.size() < max_idle)
+    e.idle.push_back({std::move(s), std::chrono::steady_clock::now()});
+  else
+    e.total--;
+}
+
+void connection_pool::purge()
+{
+  const auto now = std::chrono::steady_clock::now();
+  for (auto & [_, e] : entries_)
+    while (!e->idle.empty() && (now - e->idle.front().since) >= idle_timeout)
+    {
+      e->idle.pop_front();
+      e->total--;
+    }
+
+  std::erase_if(entries_, [](auto & kv) {return kv.second->total == 0u && kv.second->waiters.empty();});
+}
+
+void connection_pool::clear()
+{
+  for (auto & [_, e] : entries_)
+  {
+    e->total -= e->idle.size();
+    e->idle.clear();
+  }
+
+  std::erase_if(entries_, [](auto & kv) {return kv.second->total == 0u && kv.second->waiters.empty();});
+}
+
+std::size_t connection_pool::idle() const
+{
+  std::size_t n = 0u;
+  for (auto & [_, e] : entries_)
+    n += e->idle.size();
+  return n;
+}
+
+std::size_t connection_pool::size() const
+{
+  std::size_t n = 0u;
+  for (auto & [_, e] : entries_)
+    n += e->total;
+  return n;
+}
+
+void connection_pool::wait_op_::initiate(completion_handler<system::error_code, lease> h)
+{
+  auto & w = entry_.waiters.emplace_back(std::move(h));
+  if (auto slot = w.get_cancellation_slot(); slot.is_connected())
+    slot.assign(
+        [e = &entry_, wtr = std::prev(entry_.waiters.end())](asio::cancellation_type)
+        {
+          auto h = std::move(*wtr);
+          e->waiters.erase(wtr);
+          asio::post(asio::append(std::move(h), asio::error::operation_aborted, lease{}));
+        });
+}
+
+void connection_pool::acquire_op_::ready(handler<system::error_code, lease> h)
+{
+  // waiters go first, so a returned connection doesn't get taken by a newcomer.
+  auto & e = pool_.entry_for_(ep_, connector_);
+  if (e.waiters.empty())
+    if (auto l = pool_.pop_idle_(e))
+      h({}, std::move(l));
+}
+
+void connection_pool::acquire_op_::initiate(completion_handler<system::error_code, lease>)
+{
+  auto & e = pool_.entry_for_(ep_, connector_);
+  if (e.waiters.empty())
+    if (auto l = pool_.pop_idle_(e))
+      co_return {system::error_code{}, std::move(l)};
+
+  // l holds the slot while connecting, so it gets passed on if the connect fails.
+  lease l;
+  if (e.total >= pool_.max_total || !e.waiters.empty())
+  {
+    auto [ec, wl] = co_await wait_op_{e};
+    if (ec || wl)
+      co_return {ec, std::move(wl)};
+    l = std::move(wl);
+  }
+  else
+  {
+    e.total++;
+    l = lease{pool_, e, nullptr, false};
+  }
+
+  pool_.connecting_++;
+  auto [ec, s] = co_await connector_.connect(ep_);
+  pool_.connecting_--;
+  if (ec)
+    co_return {ec, lease{}};
+
+  l.socket_ = dynamic_cast<io::socket*>(s.get());
+  l.stream_ = std::move(s);
+  co_return {ec, std::move(l)};
+}
+
+}
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#define _FILE_OFFSET_BITS 64
+
+#include <boost/cobalt/io/copy_range.hpp>
+#include <boost/cobalt/io/write.hpp>
+#include <boost/cobalt/composition.hpp>
+
+#include <boost/asio/deferred.hpp>
+#include <boost/asio/post.hpp>
+
+#include <cerrno>
+#include <memory>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace boost::cobalt::io
+{
+
+void copy_range_op::initiate(completion_handler<system::error_code, std::uint64_t>)
+{
+  std::uint64_t copied = 0u;
+
+#if defined(__linux__)
+  // copy_file_range works in the kernel, i.e. it avoids the copy into user space & can reflink.
+  bool fallback = false;
+  while (copied < length_)
+  {
+    if (!!co_await this_coro::cancelled)
+      co_return {asio::error::operation_aborted, copied};
+
+    loff_t in  = static_cast<loff_t>(source_offset_ + copied);
+    loff_t out = static_cast<loff_t>(destination_offset_ + copied);
+    const auto n = ::copy_file_range(source_.native_handle(), &in,
+                                     destination_.native_handle(), &out,
+                                     static_cast<std::size_t>((std::min)(length_ - copied, static_cast<std::uint64_t>(chunk_size))),
+                                     0u);
+    if (n < 0)
+    {
+      // the kernel or filesystem doesn't support it for this pair of files, so copy through user space.
+      if (errno == EXDEV || errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP)
+      {
+        fallback = true;
+        break;
+      }
+      constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION};
+      co_return {system::error_code{errno, system::system_category(), &loc}, copied};
+    }
+    else if (n == 0)
+      co_return {asio::error::eof, copied};
+
+    copied += static_cast<std::uint64_t>(n);
+    if (progress_)
+      progress_(progress_this_, copied);
+
+    // copy_file_range is synchronous, so give the rest of the loop a chance to run between chunks.
+    if (copied < length_)
+      co_await asio::post(co_await this_coro::executor, asio::deferred);
+  }
+
+  if (!fallback)
+    co_return {system::error_code{}, copied};
+#endif
+
+  const auto buffer_size = static_cast<std::size_t>((std::min)(length_ - copied, static_cast<std::uint64_t>(chunk_size)));
+  std::unique_ptr<char[]> buf{new char[buffer_size]};
+
+  while (copied < length_)
+  {
+    if (!!co_await this_coro::cancelled)
+      co_return {asio::error::operation_aborted, copied};
+
+    const auto chunk = static_cast<std::size_t>((std::min)(length_ - copied, static_cast<std::uint64_t>(buffer_size)));
+    auto [rec, rn] = co_await source_.read_some_at(source_offset_ + copied, buffer(buf.get(), chunk));
+
+    auto [wec, wn] = co_await write_all_at{destination_.write_some_at(destination_offset_ + copied, buffer(buf.get(), rn))};
+    copied += wn;
+    if (wn > 0u && progress_)
+      progress_(progress_this_, copied);
+
+    if (wec)
+      co_return {wec, copied};
+    if (rec)
+      co_return {rec, copied};
+  }
+
+  co_return {system::error_code{}, copied};
+}
+
+}
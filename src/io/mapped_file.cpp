@@ -0,0 +1,214 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#define _FILE_OFFSET_BITS 64
+
+#include <boost/cobalt/io/mapped_file.hpp>
+
+#if !defined(BOOST_ASIO_WINDOWS)
+
+#include <boost/asio/append.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <utility>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace boost::cobalt::io
+{
+
+using boost::system::error_code;
+
+#if !defined(COBALT_RETURN_ERROR)
+#define COBALT_RETURN_ERROR()                                            \
+  do {                                                                   \
+    constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION}; \
+    return error_code{errno, ::boost::system::system_category(), &loc};  \
+  }                                                                      \
+  while(true)
+#endif
+
+namespace
+{
+
+std::size_t page_size()
+{
+  static const std::size_t sz = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  return sz;
+}
+
+// the threads that take the page faults for prefetch.
+asio::thread_pool & prefetch_pool()
+{
+  static asio::thread_pool pool{2u};
+  return pool;
+}
+
+error_code prefetch_impl(const char * data, std::size_t size)
+{
+  const auto page  = page_size();
+  const auto begin = reinterpret_cast<std::uintptr_t>(data) & ~(page - 1u);
+  const auto end   = reinterpret_cast<std::uintptr_t>(data) + size;
+
+#if defined(MADV_POPULATE_READ)
+  if (::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_POPULATE_READ) == 0)
+    return {};
+  else if (errno != EINVAL) // EINVAL means the kernel is too old, so we fall back to touching the pages.
+    COBALT_RETURN_ERROR();
+#endif
+
+  if (::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED) != 0)
+    COBALT_RETURN_ERROR();
+
+  volatile char sink = 0;
+  for (auto p = begin; p < end; p += page)
+    sink = sink ^ *reinterpret_cast<const volatile char*>(p);
+  return {};
+}
+
+}
+
+void mapped_file::prefetch_op::initiate(completion_handler<system::error_code> h)
+{
+  // keep the loop of the awaiting coroutine alive until we post back.
+  auto work = asio::prefer(h.get_executor(), asio::execution::outstanding_work.tracked);
+  asio::post(
+      prefetch_pool(),
+      [data = data_, size = size_, h = std::move(h), work = std::move(work)]() mutable
+      {
+        auto ec = prefetch_impl(data, size);
+        asio::post(asio::append(std::move(h), ec));
+      });
+}
+
+mapped_file::mapped_file(file & f, access acc, hints hs)
+{
+  map(f.native_handle(), 0u, npos, acc, hs).value();
+}
+
+mapped_file::mapped_file(file & f, std::uint64_t offset, std::size_t length, access acc, hints hs)
+{
+  map(f.native_handle(), offset, length, acc, hs).value();
+}
+
+mapped_file::mapped_file(mapped_file && lhs) noexcept
+    : data_(std::exchange(lhs.data_, nullptr)),
+      size_(std::exchange(lhs.size_, 0u)),
+      offset_(std::exchange(lhs.offset_, 0u)),
+      base_(std::exchange(lhs.base_, nullptr)),
+      base_size_(std::exchange(lhs.base_size_, 0u))
+{
+}
+
+mapped_file& mapped_file::operator=(mapped_file && lhs) noexcept
+{
+  if (this != &lhs)
+  {
+    unmap();
+    data_      = std::exchange(lhs.data_, nullptr);
+    size_      = std::exchange(lhs.size_, 0u);
+    offset_    = std::exchange(lhs.offset_, 0u);
+    base_      = std::exchange(lhs.base_, nullptr);
+    base_size_ = std::exchange(lhs.base_size_, 0u);
+  }
+  return *this;
+}
+
+mapped_file::~mapped_file()
+{
+  unmap();
+}
+
+system::result<void> mapped_file::map(file::native_handle_type fd,
+                                      std::uint64_t offset, std::size_t length,
+                                      access acc, hints hs)
+{
+  if (base_ != nullptr)
+  {
+    auto r = unmap();
+    if (r.has_error())
+      return r;
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0)
+    COBALT_RETURN_ERROR();
+
+  const auto file_size = static_cast<std::uint64_t>(st.st_size);
+  if (offset > file_size)
+  {
+    constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION};
+    return error_code{EINVAL, ::boost::system::system_category(), &loc};
+  }
+
+  length = static_cast<std::size_t>((std::min)(static_cast<std::uint64_t>(length), file_size - offset));
+  offset_ = offset;
+  if (length == 0u) // nothing to map, this is not an error.
+    return system::in_place_value;
+
+  // mmap requires a page aligned offset, so we map a little more & hide the head.
+  const auto aligned = offset - offset % page_size();
+  const auto total   = length + static_cast<std::size_t>(offset - aligned);
+
+  int prot  = PROT_READ | (acc == read_write ? PROT_WRITE : 0);
+  int flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+  if (hs & populate)
+    flags |= MAP_POPULATE;
+#endif
+
+  void * p = ::mmap(nullptr, total, prot, flags, fd, static_cast<off_t>(aligned));
+  if (p == MAP_FAILED)
+    COBALT_RETURN_ERROR();
+
+  // the rest are hints, so we ignore failures, e.g. no THP for the filesystem.
+#if defined(MADV_HUGEPAGE)
+  if (hs & huge_pages)
+    ::madvise(p, total, MADV_HUGEPAGE);
+#endif
+  if (hs & sequential)
+    ::madvise(p, total, MADV_SEQUENTIAL);
+  if (hs & random)
+    ::madvise(p, total, MADV_RANDOM);
+
+  base_ = p;
+  base_size_ = total;
+  data_ = static_cast<char*>(p) + (offset - aligned);
+  size_ = length;
+  return system::in_place_value;
+}
+
+system::result<void> mapped_file::unmap()
+{
+  if (base_ == nullptr)
+    return system::in_place_value;
+
+  const auto res = ::munmap(base_, base_size_);
+  base_ = data_ = nullptr;
+  base_size_ = size_ = 0u;
+  offset_ = 0u;
+  if (res != 0)
+    COBALT_RETURN_ERROR();
+  return system::in_place_value;
+}
+
+system::result<void> mapped_file::flush(bool async)
+{
+  if (base_ == nullptr)
+    return system::in_place_value;
+
+  if (::msync(base_, base_size_, async ? MS_ASYNC : MS_SYNC) != 0)
+    COBALT_RETURN_ERROR();
+  return system::in_place_value;
+}
+
+}
+
+#endif
@@ -47,5 +47,17 @@ void lookup::initiate(completion_handler<system::error_code, endpoint_sequence>
       asio::deferred(transformer{}))(std::move(h));
 }
 
+system_resolver_backend::system_resolver_backend(const cobalt::executor & executor, resolver::flags flags)
+    : resolver_(executor), flags_(flags) {}
+void system_resolver_backend::cancel() { resolver_.cancel(); }
 
-}
\ No newline at end of file
+void system_resolver_backend::initiate_resolve_(void * this_, std::string_view host, std::string_view service,
+                                                completion_handler<system::error_code, endpoint_sequence> h)
+{
+  auto & self = *static_cast<system_resolver_backend*>(this_);
+  self.resolver_.async_resolve(
+      cobalt::io::ip, host, service, self.flags_,
+      asio::deferred(transformer{}))(std::move(h));
+}
+
+}
@@ -10,6 +10,18 @@
 #include <boost/asio/local/stream_protocol.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/connect.hpp>
+#include <boost/asio/append.hpp>
+#include <boost/asio/basic_stream_socket.hpp>
+#include <boost/asio/post.hpp>
+
+#include <boost/cobalt/io/sleep.hpp>
+#include <boost/cobalt/join.hpp>
+#include <boost/cobalt/race.hpp>
+#include <boost/cobalt/result.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 namespace boost::cobalt::io
 {
@@ -216,5 +228,150 @@ void socket::ranged_connect_op::initiate(completion_handler<error_code, endpoint
       sock_.socket_, endpoints, std::move(handler));
 }
 
+namespace
+{
+
+using attempt_socket = asio::basic_stream_socket<protocol_type, executor>;
+
+promise<error_code> connect_attempt(asio::executor_arg_t, executor, attempt_socket & sock, endpoint ep)
+{
+  auto [ec] = co_await as_tuple(sock.async_connect(ep, use_op));
+  co_return ec;
+}
+
+promise<error_code> connect_delay(asio::executor_arg_t, executor, std::chrono::steady_clock::duration delay)
+{
+  auto [ec] = co_await as_tuple(io::sleep(delay));
+  co_return ec;
+}
+
+}
+
+void socket::staggered_connect_op::initiate(completion_handler<error_code, endpoint> handler)
+{
+  // assign first, the runner might complete right away.
+  if (auto slot = handler.get_cancellation_slot(); slot.is_connected())
+    slot.assign(
+        [this](asio::cancellation_type ct)
+        {
+          if (runner_)
+            runner_->cancel(ct);
+        });
+
+  auto exec = handler.get_executor();
+  runner_.emplace(run_(asio::executor_arg, exec, *this, std::move(handler)));
+}
+
+promise<void> socket::staggered_connect_op::run_(asio::executor_arg_t, executor exec,
+                                                 staggered_connect_op & op,
+                                                 completion_handler<error_code, endpoint> handler)
+{
+  co_await this_coro::throw_if_cancelled(false);
+
+  // RFC 8305 section 4: interleave the address families, starting with the first one.
+  auto & eps = op.endpoints;
+  if (!eps.empty())
+  {
+    const auto first = eps.front().protocol().family();
+    const auto mid = std::stable_partition(eps.begin(), eps.end(),
+                                           [&](const endpoint & ep) {return ep.protocol().family() == first;});
+    endpoint_sequence sorted(eps.get_allocator());
+    sorted.reserve(eps.size());
+    for (auto a = eps.begin(), b = mid; a != mid || b != eps.end();)
+    {
+      if (a != mid)
+        sorted.push_back(*a++);
+      if (b != eps.end())
+        sorted.push_back(*b++);
+    }
+    eps = std::move(sorted);
+  }
+
+  for (auto & ep : eps)
+    op.sock_.adopt_endpoint_(ep);
+
+  // sockets[i] connects to eps[i]. The reserve makes sure they don't move while connecting.
+  std::vector<attempt_socket> sockets;
+  sockets.reserve(eps.size());
+
+  // owners[i] is the socket index of attempts[i], or npos for the delay.
+  constexpr auto npos = std::numeric_limits<std::size_t>::max();
+  std::vector<promise<error_code>> attempts;
+  std::vector<std::size_t> owners;
+
+  std::size_t next = 0u;
+  auto start_next =
+      [&]
+      {
+        // built with the executor of the socket, so the winner can replace it without rebinding it.
+        auto & sock = sockets.emplace_back(op.sock_.socket_.get_executor());
+        attempts.push_back(connect_attempt(asio::executor_arg, exec, sock, eps[next++]));
+        owners.push_back(sockets.size() - 1u);
+
+        for (std::size_t i = 0u; i < owners.size(); i++)
+          if (owners[i] == npos)
+            attempts[i].cancel();
+
+        if (next < eps.size())
+        {
+          attempts.push_back(connect_delay(asio::executor_arg, exec, op.delay));
+          owners.push_back(npos);
+        }
+      };
+
+  error_code ec = asio::error::host_not_found;
+  std::size_t winner = npos;
+  if (!eps.empty())
+    start_next();
+
+  // the promises are lvalues, so race will only interrupt the ones that lose, not cancel them.
+  while (winner == npos && !attempts.empty())
+  {
+    auto [idx, res] = co_await race(attempts);
+    const auto owner = owners[idx];
+    attempts.erase(attempts.begin() + idx);
+    owners.erase(owners.begin() + idx);
+
+    if ((co_await this_coro::cancelled) != asio::cancellation_type::none)
+    {
+      ec = asio::error::operation_aborted;
+      break;
+    }
+
+    if (owner == npos)
+    {
+      // a cancelled delay was replaced by the attempt that cancelled it.
+      if (!res && next < eps.size())
+        start_next();
+    }
+    else if (!res)
+      winner = owner;
+    else
+    {
+      ec = res;
+      if (next < eps.size())
+        start_next();
+    }
+  }
+
+  // the losers need to be done before the sockets go out of scope.
+  for (auto & a : attempts)
+    a.cancel();
+  if (!attempts.empty())
+    co_await join(attempts);
+
+  endpoint ep;
+  if (winner != npos)
+  {
+    // replaces the socket, including its options & a bind, see the docs.
+    op.sock_.socket_ = std::move(sockets[winner]);
+    ep = eps[winner];
+    ec = {};
+  }
+
+  handler.get_cancellation_slot().clear();
+  asio::post(asio::append(std::move(handler), ec, ep));
+}
+
 
 }
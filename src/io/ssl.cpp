@@ -7,6 +7,21 @@
 
 #include <boost/cobalt/io/ssl.hpp>
 #include <boost/cobalt/io/stream_socket.hpp>
+#include <boost/cobalt/composition.hpp>
+
+#include <boost/asio/append.hpp>
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/deferred.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <openssl/rand.h>
+
+#include <algorithm>
+#include <ctime>
+#include <list>
+#include <mutex>
+#include <vector>
 
 namespace boost::cobalt::io::ssl
 {
@@ -68,19 +83,104 @@ void stream::initiate_read_some_(void *this_ , mutable_buffer_sequence buffer,
 void stream::initiate_write_some_(void * this_, const_buffer_sequence buffer,
                                       boost::cobalt::completion_handler<system::error_code, std::size_t> handler)
 {
-  visit(buffer, [&](auto buf)
-  {
-    auto t = static_cast<stream*>(this_);
-    if (t->upgraded_)
-      t->stream_socket_.async_write_some(buf, std::move(handler))  ;
-    else
+  auto t = static_cast<stream*>(this_);
+  if (!t->upgraded_)
+    return visit(buffer, [&](auto buf)
+    {
       t->stream_socket_.next_layer().async_write_some(buf, std::move(handler));
-  });
+    });
+
+  // asio encrypts the first buffer only, so a sequence of small buffers gets copied into one record.
+  const auto limit = t->record_limit_();
+  const asio::const_buffer head = *buffer.begin();
+  asio::const_buffer record;
+  if (buffer.buffer_count() == 1u || head.size() >= limit)
+    record = asio::buffer(head, limit);
+  else
+  {
+    if (!t->record_buffer_)
+      t->record_buffer_ = std::make_unique<char[]>(max_record_size);
+    record = asio::buffer(t->record_buffer_.get(),
+                          asio::buffer_copy(asio::buffer(t->record_buffer_.get(), limit), buffer));
+  }
+
+  t->stream_socket_.async_write_some(
+      record,
+      asio::deferred(
+          [&written = t->bytes_written_](system::error_code ec, std::size_t n)
+          {
+            written += n;
+            return asio::deferred.values(ec, n);
+          }))(std::move(handler));
+}
+
+std::size_t stream::record_limit_()
+{
+  // start small again after being idle, like tcp's slow start after idle.
+  const auto now = std::chrono::steady_clock::now();
+  if (now - last_write_ > record_idle_reset)
+    bytes_written_ = 0u;
+  last_write_ = now;
+
+  return bytes_written_ < record_boost_threshold
+       ? (std::min)(small_record_size, max_record_size)
+       : max_record_size;
+}
+
+namespace
+{
+
+// Runs the handshake on a strand of the worker executor. The socket operations get initiated from there,
+// and every step completes on the worker, because that's the associated executor of the handler.
+template<typename Initiation, typename ... Args>
+void offload_handshake(asio::any_io_executor worker,
+                       asio::ssl::stream<asio::basic_stream_socket<protocol_type, executor>> & str,
+                       bool & upgraded,
+                       Initiation initiation,
+                       completion_handler<system::error_code, Args...> handler)
+{
+  auto strand = asio::make_strand(std::move(worker));
+  // only touched on the strand.
+  auto done = std::make_shared<bool>(false);
+
+  if (auto slot = handler.get_cancellation_slot(); slot.is_connected())
+    slot.assign(
+        [strand, done, &str](asio::cancellation_type)
+        {
+          asio::post(strand,
+                     [done, &str]
+                     {
+                       system::error_code ec;
+                       if (!*done)
+                         str.lowest_layer().cancel(ec);
+                     });
+        });
+
+  // the event loop doesn't have any pending operations while a step runs on the worker.
+  auto work = asio::prefer(handler.get_executor(), asio::execution::outstanding_work.tracked);
+  asio::post(
+      strand,
+      [strand, done, &upgraded, initiation = std::move(initiation),
+       handler = std::move(handler), work = std::move(work)]() mutable
+      {
+        initiation(
+            asio::bind_executor(
+                strand,
+                [done, &upgraded, handler = std::move(handler), work = std::move(work)](system::error_code ec, Args ... args) mutable
+                {
+                  *done = true;
+                  if (!ec)
+                    upgraded = true;
+                  asio::post(asio::append(std::move(handler), ec, std::move(args)...));
+                }));
+      });
+}
+
 }
 
 void stream::handshake_op_::ready(handler<system::error_code> handler)
 {
-  if (upgraded_)
+  if (stream_.upgraded_)
   {
     constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION};
     handler(system::error_code{asio::error::already_started});
@@ -89,12 +189,30 @@ void stream::handshake_op_::ready(handler<system::error_code> handler)
 
 void stream::handshake_op_::initiate(completion_handler<system::error_code> handler)
 {
-  stream_socket_.async_handshake(type_, std::move(handler));
+  stream_.prepare_handshake_(type_);
+  if (stream_.handshake_executor_)
+    return offload_handshake(
+        stream_.handshake_executor_, stream_.stream_socket_, stream_.upgraded_,
+        [&str = stream_.stream_socket_, type = type_](auto && token)
+        {
+          str.async_handshake(type, std::move(token));
+        },
+        std::move(handler));
+
+  stream_.stream_socket_.async_handshake(
+      type_,
+      asio::deferred(
+          [&upgraded = stream_.upgraded_](system::error_code ec)
+          {
+            if (!ec)
+              upgraded = true;
+            return asio::deferred.values(ec);
+          }))(std::move(handler));
 }
 
 void stream::handshake_buffer_op_::ready(handler<system::error_code, std::size_t> handler)
 {
-  if (upgraded_)
+  if (stream_.upgraded_)
   {
     constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION};
     handler(system::error_code{asio::error::already_started}, 0ull);
@@ -103,7 +221,25 @@ void stream::handshake_buffer_op_::ready(handler<system::error_code, std::size_t
 
 void stream::handshake_buffer_op_::initiate(completion_handler<system::error_code, std::size_t> handler)
 {
-  stream_socket_.async_handshake(type_, buffer_, std::move(handler));
+  stream_.prepare_handshake_(type_);
+  if (stream_.handshake_executor_)
+    return offload_handshake(
+        stream_.handshake_executor_, stream_.stream_socket_, stream_.upgraded_,
+        [&str = stream_.stream_socket_, type = type_, buffer = buffer_](auto && token)
+        {
+          str.async_handshake(type, buffer, std::move(token));
+        },
+        std::move(handler));
+
+  stream_.stream_socket_.async_handshake(
+      type_, buffer_,
+      asio::deferred(
+          [&upgraded = stream_.upgraded_](system::error_code ec, std::size_t n)
+          {
+            if (!ec)
+              upgraded = true;
+            return asio::deferred.values(ec, n);
+          }))(std::move(handler));
 }
 
 void stream::shutdown_op_::ready(handler<system::error_code> handler)
@@ -135,4 +271,200 @@ system::result<void> stream::set_verify_mode(verify mode)
   stream_socket_.set_verify_mode(static_cast<asio::ssl::verify_mode>(mode), ec);
   return ec ? ec : system::result<void>();
 }
-}
\ No newline at end of file
+system::result<void> stream::set_server_name(std::string_view name)
+{
+  const std::string n{name};
+  if (SSL_set_tlsext_host_name(stream_socket_.native_handle(), n.c_str()) != 1)
+    return system::error_code(static_cast<int>(::ERR_get_error()), asio::error::get_ssl_category());
+  return system::in_place_value;
+}
+
+bool stream::resumed() const
+{
+  return SSL_session_reused(const_cast<stream*>(this)->stream_socket_.native_handle()) == 1;
+}
+
+namespace
+{
+
+int session_cache_index()
+{
+  static const int idx = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  return idx;
+}
+
+int session_key_index()
+{
+  static const int idx = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  return idx;
+}
+
+}
+
+struct session_cache::impl
+{
+  std::mutex mtx;
+  // the oldest session is at the front.
+  std::list<std::pair<std::string, SSL_SESSION*>> sessions;
+
+  ~impl()
+  {
+    for (auto & [_, s] : sessions)
+      SSL_SESSION_free(s);
+  }
+
+  // takes ownership of session
+  void put(std::string_view key, SSL_SESSION * session, std::size_t max_entries)
+  {
+    std::lock_guard<std::mutex> lock{mtx};
+    auto itr = std::find_if(sessions.begin(), sessions.end(), [&](auto & p) {return p.first == key;});
+    if (itr != sessions.end())
+    {
+      SSL_SESSION_free(itr->second);
+      sessions.erase(itr);
+    }
+
+    while (!sessions.empty() && sessions.size() >= max_entries)
+    {
+      SSL_SESSION_free(sessions.front().second);
+      sessions.pop_front();
+    }
+    if (max_entries > 0u)
+      sessions.emplace_back(std::string(key), session);
+    else
+      SSL_SESSION_free(session);
+  }
+
+  // tls 1.3 tickets shouldn't be reused, so these sessions get removed when they're taken.
+  // tls 1.2 sessions usually don't get renewed on resumption, so they stay until they expire.
+  SSL_SESSION * take(std::string_view key)
+  {
+    std::lock_guard<std::mutex> lock{mtx};
+    auto itr = std::find_if(sessions.begin(), sessions.end(), [&](auto & p) {return p.first == key;});
+    if (itr == sessions.end())
+      return nullptr;
+
+    auto session = itr->second;
+    const auto expiry = SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session);
+    if (SSL_SESSION_is_resumable(session) != 1 || expiry <= static_cast<long>(std::time(nullptr)))
+    {
+      sessions.erase(itr);
+      SSL_SESSION_free(session);
+      return nullptr;
+    }
+
+    if (SSL_SESSION_get_protocol_version(session) >= TLS1_3_VERSION)
+    {
+      sessions.erase(itr);
+      return session;
+    }
+    // a copy, since the session of a stream might get marked as not resumable, see new_session_.
+    return SSL_SESSION_dup(session);
+  }
+};
+
+session_cache::session_cache(std::size_t max_entries) : max_entries(max_entries), impl_(std::make_unique<impl>())
+{
+}
+
+session_cache::~session_cache() = default;
+
+system::result<void> session_cache::attach(context & ctx)
+{
+  const auto c = ctx.native_handle();
+  if (SSL_CTX_set_ex_data(c, session_cache_index(), this) != 1)
+    return system::error_code(static_cast<int>(::ERR_get_error()), asio::error::get_ssl_category());
+
+  // the internal store is server side only, the cache keeps the client sessions.
+  SSL_CTX_set_session_cache_mode(c, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  SSL_CTX_sess_set_new_cb(c, &session_cache::new_session_);
+  return system::in_place_value;
+}
+
+std::size_t session_cache::size() const
+{
+  std::lock_guard<std::mutex> lock{impl_->mtx};
+  return impl_->sessions.size();
+}
+
+void session_cache::clear()
+{
+  std::lock_guard<std::mutex> lock{impl_->mtx};
+  for (auto & [_, s] : impl_->sessions)
+    SSL_SESSION_free(s);
+  impl_->sessions.clear();
+}
+
+int session_cache::new_session_(SSL * ssl, SSL_SESSION * session)
+{
+  auto cache = static_cast<session_cache*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), session_cache_index()));
+  auto key = static_cast<const std::string*>(SSL_get_ex_data(ssl, session_key_index()));
+  if (cache == nullptr || key == nullptr)
+    return 0;
+
+  // openssl marks the session of a stream that's closed without shutdown as not resumable, so store a copy.
+  if (auto copy = SSL_SESSION_dup(session))
+    cache->impl_->put(*key, copy, cache->max_entries);
+  return 0;
+}
+
+void stream::prepare_handshake_(handshake_type type)
+{
+  const auto ssl = stream_socket_.native_handle();
+  auto cache = static_cast<session_cache*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), session_cache_index()));
+  if (type != client || cache == nullptr)
+    return;
+
+  // the key is the server name & the remote endpoint, i.e. including the port.
+  session_key_.clear();
+  if (auto name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name))
+    session_key_ = name;
+  session_key_.push_back('\0');
+  system::error_code ec;
+  const auto ep = stream_socket_.lowest_layer().remote_endpoint(ec);
+  if (!ec)
+    session_key_.append(static_cast<const char*>(ep.data()), ep.size());
+  SSL_set_ex_data(ssl, session_key_index(), &session_key_);
+
+  if (auto session = cache->impl_->take(session_key_))
+  {
+    SSL_set_session(ssl, session);
+    SSL_SESSION_free(session);
+  }
+}
+
+system::result<void> rotate_ticket_keys(context & ctx)
+{
+  const auto c = ctx.native_handle();
+  const auto size = SSL_CTX_get_tlsext_ticket_keys(c, nullptr, 0);
+  if (size <= 0)
+  {
+    constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION};
+    return {system::in_place_error, asio::error::operation_not_supported, &loc};
+  }
+
+  std::vector<unsigned char> keys(static_cast<std::size_t>(size));
+  const bool done = RAND_bytes(keys.data(), static_cast<int>(keys.size())) == 1
+                 && SSL_CTX_set_tlsext_ticket_keys(c, keys.data(), static_cast<long>(keys.size())) == 1;
+  OPENSSL_cleanse(keys.data(), keys.size());
+  if (!done)
+    return system::error_code(static_cast<int>(::ERR_get_error()), asio::error::get_ssl_category());
+  return system::in_place_value;
+}
+
+connector::connector(context & ctx, const cobalt::executor & exec) : context_(ctx), executor_(exec) {}
+
+void connector::initiate_connect_(void * this_, endpoint ep,
+                                  completion_handler<system::error_code, std::unique_ptr<io::stream>>)
+{
+  auto & self = *static_cast<connector*>(this_);
+  auto s = std::make_unique<stream>(self.context_, self.executor_);
+  auto [ec] = co_await s->connect(ep);
+  if (!ec)
+    std::tie(ec) = co_await s->handshake(stream::client);
+  if (ec)
+    co_return {ec, nullptr};
+  co_return {ec, std::unique_ptr<io::stream>(std::move(s))};
+}
+
+}
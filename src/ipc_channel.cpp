@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/ipc_channel.hpp>
+
+#if defined(__linux__)
+
+#include <boost/system/system_error.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <new>
+#include <utility>
+
+namespace boost::cobalt
+{
+
+namespace
+{
+
+constexpr std::size_t slots_offset = (sizeof(detail::ipc_ring_header) + 63u) & ~std::size_t(63u);
+
+system::error_code last_error()
+{
+  return system::error_code(errno, system::system_category());
+}
+
+}
+
+system::result<ipc_ring> ipc_ring::create(std::size_t capacity, std::size_t element_size)
+{
+  if (capacity == 0u || element_size == 0u)
+  {
+    constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION};
+    return {system::in_place_error, asio::error::invalid_argument, &loc};
+  }
+
+  ipc_ring ring;
+  ring.mapped_size_ = slots_offset + capacity * element_size;
+  // anonymous & shared, so it gets inherited by fork().
+  const auto p = ::mmap(nullptr, ring.mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED)
+    return last_error();
+
+  ring.header_ = new (p) detail::ipc_ring_header();
+  ring.header_->capacity = capacity;
+  ring.header_->element_size = element_size;
+
+  if ((ring.readable_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) == -1)
+    return last_error();
+  if ((ring.writable_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) == -1)
+    return last_error();
+  return ring;
+}
+
+ipc_ring::ipc_ring(ipc_ring && lhs) noexcept
+    : header_(std::exchange(lhs.header_, nullptr)),
+      mapped_size_(std::exchange(lhs.mapped_size_, 0u)),
+      readable_fd_(std::exchange(lhs.readable_fd_, -1)),
+      writable_fd_(std::exchange(lhs.writable_fd_, -1))
+{
+}
+
+ipc_ring& ipc_ring::operator=(ipc_ring && lhs) noexcept
+{
+  if (this != &lhs)
+  {
+    this->~ipc_ring();
+    header_      = std::exchange(lhs.header_, nullptr);
+    mapped_size_ = std::exchange(lhs.mapped_size_, 0u);
+    readable_fd_ = std::exchange(lhs.readable_fd_, -1);
+    writable_fd_ = std::exchange(lhs.writable_fd_, -1);
+  }
+  return *this;
+}
+
+ipc_ring::~ipc_ring()
+{
+  if (header_)
+    ::munmap(header_, mapped_size_);
+  if (readable_fd_ != -1)
+    ::close(readable_fd_);
+  if (writable_fd_ != -1)
+    ::close(writable_fd_);
+  header_ = nullptr;
+  readable_fd_ = writable_fd_ = -1;
+}
+
+namespace detail
+{
+
+namespace
+{
+
+// every channel gets its own descriptor, so it can be registered with the io_context of its process.
+int dup_fd(int fd)
+{
+  const int res = ::dup(fd);
+  if (res == -1)
+  {
+    constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION};
+    boost::throw_exception(system::system_error(last_error(), "ipc_channel"), loc);
+  }
+  return res;
+}
+
+}
+
+ipc_channel_base::ipc_channel_base(ipc_ring & ring, std::size_t element_size, const executor & exec)
+    : header_(ring.header_),
+      slots_(reinterpret_cast<char*>(ring.header_) + slots_offset),
+      readable_(exec, dup_fd(ring.readable_fd_)),
+      writable_(exec, dup_fd(ring.writable_fd_))
+{
+  if (header_->element_size != element_size)
+  {
+    constexpr static boost::source_location loc{BOOST_CURRENT_LOCATION};
+    boost::throw_exception(system::system_error(asio::error::invalid_argument, "ipc_channel element size"), loc);
+  }
+}
+
+void ipc_channel_base::close()
+{
+  header_->closed.store(1u, std::memory_order_release);
+  notify_(readable_);
+  notify_(writable_);
+}
+
+void ipc_channel_base::notify_(descriptor_type & desc)
+{
+  const std::uint64_t one = 1u;
+  // can only fail with EAGAIN if the counter overflows, in which case the other side gets woken up anyhow.
+  [[maybe_unused]] const auto n = ::write(desc.native_handle(), &one, sizeof(one));
+}
+
+void ipc_channel_base::wait_op_::initiate(completion_handler<system::error_code>)
+{
+  auto & h = *chan_.header_;
+  auto & waiting = reading_ ? h.reader_waiting : h.writer_waiting;
+  auto & desc = reading_ ? chan_.readable_ : chan_.writable_;
+
+  waiting.store(1u, std::memory_order_relaxed);
+  // pairs with the fence in try_read_/try_write_, so we either see the change or get notified.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  const auto head = h.head.load(std::memory_order_acquire);
+  const auto tail = h.tail.load(std::memory_order_acquire);
+  const bool ready = (reading_ ? head != tail : head - tail < h.capacity)
+                   || h.closed.load(std::memory_order_acquire) != 0u;
+
+  system::error_code ec;
+  if (!ready)
+  {
+    std::tie(ec) = co_await desc.async_wait(descriptor_type::wait_read);
+    // reset the counter, spurious wakeups from an old notification just lead to a retry.
+    std::uint64_t cnt;
+    [[maybe_unused]] const auto n = ::read(desc.native_handle(), &cnt, sizeof(cnt));
+  }
+
+  waiting.store(0u, std::memory_order_relaxed);
+  co_return {ec};
+}
+
+void ipc_channel_base::write_op_::ready(handler<system::error_code> h)
+{
+  if (!chan_.is_open())
+    return h(asio::error::broken_pipe);
+  if (chan_.try_write_(data_) || chan_.spin_([this]{return chan_.try_write_(data_);}))
+    h({});
+}
+
+void ipc_channel_base::write_op_::initiate(completion_handler<system::error_code>)
+{
+  while (chan_.is_open())
+  {
+    if (chan_.try_write_(data_))
+      co_return {system::error_code{}};
+    auto [ec] = co_await wait_op_{chan_, false};
+    if (ec)
+      co_return {ec};
+  }
+  co_return {asio::error::broken_pipe};
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,29 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/latch.hpp>
+
+#include <algorithm>
+
+namespace boost::cobalt
+{
+
+latch::~latch()
+{
+  detail::destroy_waiters(waiters_);
+}
+
+void latch::count_down(std::size_t n)
+{
+  if (count_ == 0u)
+    return;
+  count_ -= (std::min)(n, count_);
+  if (count_ == 0u)
+    detail::complete_all(waiters_, executor_);
+}
+
+}
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/mutex.hpp>
+#include <boost/cobalt/result.hpp>
+
+namespace boost::cobalt
+{
+
+mutex::~mutex()
+{
+  detail::destroy_waiters(waiters_);
+}
+
+bool mutex::try_lock()
+{
+  if (locked_)
+    return false;
+  return locked_ = true;
+}
+
+void mutex::unlock()
+{
+  BOOST_ASSERT(locked_);
+  // hand over the lock, i.e. it stays locked.
+  if (!waiters_.empty())
+    waiters_.front().complete();
+  else
+    locked_ = false;
+}
+
+system::result<void> mutex::lock_op::await_resume(const struct as_result_tag &)
+{
+  auto res = result();
+  if (res && !direct)
+    mtx->locked_ = true;
+  return res;
+}
+
+void mutex::lock_op::await_resume()
+{
+  await_resume(as_result_tag{}).value(loc);
+}
+
+std::tuple<system::error_code> mutex::lock_op::await_resume(const struct as_tuple_tag & )
+{
+  return await_resume(as_result_tag{}).error();
+}
+
+shared_mutex::~shared_mutex()
+{
+  detail::destroy_waiters(waiters_);
+}
+
+bool shared_mutex::try_lock()
+{
+  if (!can_lock_())
+    return false;
+  return locked_ = true;
+}
+
+bool shared_mutex::try_lock_shared()
+{
+  if (!can_lock_shared_())
+    return false;
+  shared_++;
+  return true;
+}
+
+void shared_mutex::unlock()
+{
+  BOOST_ASSERT(locked_);
+  locked_ = false;
+  dispatch_();
+}
+
+void shared_mutex::unlock_shared()
+{
+  BOOST_ASSERT(shared_ > 0u);
+  if (--shared_ == 0u)
+    dispatch_();
+}
+
+void shared_mutex::dispatch_()
+{
+  // either one exclusive waiter or all shared waiters up to the next exclusive one.
+  while (!waiters_.empty() && !locked_)
+  {
+    auto & w = waiters_.front();
+    if (w.shared)
+      shared_++;
+    else if (shared_ == 0u)
+      locked_ = true;
+    else
+      break;
+    w.complete();
+  }
+}
+
+system::result<void> shared_mutex::lock_op::await_resume(const struct as_result_tag &)
+{
+  auto res = result();
+  if (res && !direct)
+  {
+    if (shared)
+      mtx->shared_++;
+    else
+      mtx->locked_ = true;
+  }
+  return res;
+}
+
+void shared_mutex::lock_op::await_resume()
+{
+  await_resume(as_result_tag{}).value(loc);
+}
+
+std::tuple<system::error_code> shared_mutex::lock_op::await_resume(const struct as_tuple_tag & )
+{
+  return await_resume(as_result_tag{}).error();
+}
+
+}
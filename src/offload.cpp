@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/offload.hpp>
+
+#include <boost/asio/thread_pool.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace boost::cobalt
+{
+
+namespace
+{
+
+std::atomic<std::size_t> pool_threads{(std::max)(1u, std::thread::hardware_concurrency())};
+std::atomic<bool> pool_started{false};
+
+std::atomic<std::size_t> queued{0u}, running{0u};
+std::atomic<std::uint64_t> completed{0u};
+
+std::size_t start_pool()
+{
+  pool_started = true;
+  return pool_threads;
+}
+
+asio::thread_pool & offload_pool()
+{
+  static asio::thread_pool pool{start_pool()};
+  return pool;
+}
+
+}
+
+offload_stats get_offload_stats()
+{
+  return offload_stats{
+      pool_started ? pool_threads.load() : 0u,
+      queued.load(std::memory_order_relaxed),
+      running.load(std::memory_order_relaxed),
+      completed.load(std::memory_order_relaxed)};
+}
+
+bool set_offload_threads(std::size_t n)
+{
+  if (pool_started || n == 0u)
+    return false;
+  pool_threads = n;
+  return true;
+}
+
+namespace detail
+{
+
+void post_offload(offload_work & work)
+{
+  queued.fetch_add(1u, std::memory_order_relaxed);
+  asio::post(offload_pool(),
+             [&work]
+             {
+               queued.fetch_sub(1u, std::memory_order_relaxed);
+               running.fetch_add(1u, std::memory_order_relaxed);
+               // this resumes the awaiting coroutine, so work must not be used afterwards.
+               work.run(&work);
+               running.fetch_sub(1u, std::memory_order_relaxed);
+               completed.fetch_add(1u, std::memory_order_relaxed);
+             });
+}
+
+}
+
+}
@@ -0,0 +1,52 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/semaphore.hpp>
+#include <boost/cobalt/result.hpp>
+
+namespace boost::cobalt
+{
+
+semaphore::~semaphore()
+{
+  detail::destroy_waiters(waiters_);
+}
+
+bool semaphore::try_acquire()
+{
+  if (count_ == 0u || !waiters_.empty())
+    return false;
+  count_--;
+  return true;
+}
+
+void semaphore::release(std::size_t n)
+{
+  for (; n > 0u && !waiters_.empty(); n--)
+    waiters_.front().complete();
+  count_ += n;
+}
+
+system::result<void> semaphore::acquire_op::await_resume(const struct as_result_tag &)
+{
+  auto res = result();
+  if (res && !direct)
+    sem->count_--;
+  return res;
+}
+
+void semaphore::acquire_op::await_resume()
+{
+  await_resume(as_result_tag{}).value(loc);
+}
+
+std::tuple<system::error_code> semaphore::acquire_op::await_resume(const struct as_tuple_tag & )
+{
+  return await_resume(as_result_tag{}).error();
+}
+
+}
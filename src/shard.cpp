@@ -0,0 +1,153 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/shard.hpp>
+#include <boost/cobalt/spawn.hpp>
+#include <boost/cobalt/this_thread.hpp>
+#include <boost/cobalt/detail/thread.hpp>
+
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/signal_set.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace boost::cobalt::detail
+{
+
+namespace
+{
+
+struct shard_state
+{
+  asio::io_context ctx{BOOST_ASIO_CONCURRENCY_HINT_1};
+  // keeps the shard running until every shard is done, so they can still post to each other.
+  std::optional<asio::executor_work_guard<asio::io_context::executor_type>> work{ctx.get_executor()};
+  asio::cancellation_signal signal;
+  std::exception_ptr error;
+  int result = 0;
+};
+
+void pin_thread(std::size_t idx)
+{
+  const auto cores = (std::max)(std::thread::hardware_concurrency(), 1u);
+  thread_options opts;
+  opts.name = "shard-" + std::to_string(idx);
+  opts.cpus.push_back(static_cast<unsigned>(idx % cores));
+  apply_thread_options(opts);
+}
+
+}
+
+int run_sharded(const shard_options & opts, void * fn, task<int> (*invoke)(void *, shard &))
+{
+  const std::size_t n = opts.shards != 0u ? opts.shards : (std::max)(std::thread::hardware_concurrency(), 1u);
+
+  std::vector<std::unique_ptr<shard_state>> states;
+  std::vector<executor> executors;
+  states.reserve(n);
+  executors.reserve(n);
+  for (std::size_t i = 0u; i < n; i++)
+    executors.push_back(states.emplace_back(std::make_unique<shard_state>())->ctx.get_executor());
+
+  // the calling thread only handles the signals & waits for the shards.
+  asio::io_context ctx{BOOST_ASIO_CONCURRENCY_HINT_1};
+  std::optional<asio::executor_work_guard<asio::io_context::executor_type>> work{ctx.get_executor()};
+  asio::signal_set ss{ctx};
+  if (opts.handle_signals)
+  {
+    ss.add(SIGINT);
+    ss.add(SIGTERM);
+  }
+
+  struct signal_handler
+  {
+    asio::signal_set & ss;
+    std::vector<std::unique_ptr<shard_state>> & states;
+    void operator()(system::error_code ec, int sig) const
+    {
+      BOOST_ASIO_HANDLER_LOCATION((__FILE__, __LINE__, __func__));
+      if (ec)
+        return;
+      const auto ct = sig == SIGINT ? asio::cancellation_type::total : asio::cancellation_type::terminal;
+      for (auto & st : states)
+        asio::post(st->ctx, [&sig = st->signal, ct] {sig.emit(ct);});
+      ss.async_wait(*this);
+    }
+  };
+  if (opts.handle_signals)
+    ss.async_wait(signal_handler{ss, states});
+
+  std::atomic<std::size_t> running{n};
+  auto shard_done =
+      [&]
+      {
+        if (--running != 0u)
+          return;
+        // the last shard to finish releases all the others & the calling thread.
+        for (auto & st : states)
+          st->work.reset();
+        asio::post(ctx, [&] {ss.cancel(); work.reset();});
+      };
+
+  auto run_shard =
+      [&](std::size_t idx)
+      {
+        if (opts.pin)
+          pin_thread(idx);
+
+        auto & st = *states[idx];
+#if !defined(BOOST_COBALT_NO_PMR)
+        pmr::unsynchronized_pool_resource resource;
+        auto prev_resource = this_thread::set_default_resource(&resource);
+#endif
+        this_thread::set_executor(executors[idx]);
+        {
+          shard sh{idx, executors};
+          spawn(st.ctx, invoke(fn, sh),
+                asio::bind_cancellation_slot(
+                    st.signal.slot(),
+                    [&](std::exception_ptr ep, int res)
+                    {
+                      st.error = ep;
+                      st.result = res;
+                      shard_done();
+                    }));
+          st.ctx.run();
+        }
+#if !defined(BOOST_COBALT_NO_PMR)
+        this_thread::set_default_resource(prev_resource);
+#endif
+      };
+
+  std::vector<std::thread> threads;
+  threads.reserve(n);
+  for (std::size_t i = 0u; i < n; i++)
+    threads.emplace_back(run_shard, i);
+
+  ctx.run();
+  for (auto & thr : threads)
+    thr.join();
+
+  for (auto & st : states)
+    if (st->error)
+      std::rethrow_exception(st->error);
+  for (auto & st : states)
+    if (st->result != 0)
+      return st->result;
+  return 0;
+}
+
+}
@@ -12,6 +12,17 @@
 
 #include <boost/core/no_exceptions_support.hpp>
 
+#if !defined(BOOST_ASIO_WINDOWS)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace boost::cobalt
 {
 
@@ -22,13 +33,65 @@ thread_promise::thread_promise()
     : promise_cancellation_base<asio::cancellation_slot, asio::enable_total_cancellation>(
     signal_helper_2::signal.slot(), asio::enable_total_cancellation())
 {
-  mtx.lock();
+}
+
+namespace
+{
+
+// touches every page of the stack below the current frame.
+BOOST_NOINLINE void touch_stack(std::size_t n)
+{
+  volatile char page[4096];
+  page[0] = 0;
+  if (n > sizeof(page))
+    touch_stack(n - sizeof(page));
+  page[sizeof(page) - 1u] = 0;
+}
+
+}
+
+void apply_thread_options(const thread_options & opts)
+{
+#if defined(__linux__)
+  if (!opts.name.empty())
+    pthread_setname_np(pthread_self(), opts.name.substr(0u, 15u).c_str());
+
+  if (!opts.cpus.empty())
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : opts.cpus)
+      if (cpu < static_cast<unsigned>(CPU_SETSIZE))
+        CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  }
+
+  if (opts.nice)
+    setpriority(PRIO_PROCESS, static_cast<id_t>(::syscall(SYS_gettid)), *opts.nice);
+#elif defined(__APPLE__)
+  if (!opts.name.empty())
+    pthread_setname_np(opts.name.c_str());
+#endif
+
+#if !defined(BOOST_ASIO_WINDOWS)
+  if (opts.fifo_priority != 0)
+  {
+    sched_param param{};
+    param.sched_priority = opts.fifo_priority;
+    pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+  }
+#endif
+
+  if (opts.prefault_stack > 0u)
+    touch_stack(opts.prefault_stack);
 }
 
 void run_thread(
     std::shared_ptr<thread_state> st_,
-    unique_handle<thread_promise> h)
+    unique_handle<thread_promise> h,
+    const thread_options & opts)
 {
+  apply_thread_options(opts);
 
 #if !defined(BOOST_COBALT_NO_PMR)
   pmr::unsynchronized_pool_resource resource;
@@ -46,7 +109,8 @@ void run_thread(
         st->ctx.get_executor(),
         [st, h = std::move(h)]() mutable
         {
-          std::lock_guard<std::mutex> lock{h->mtx};
+          // the thread got started from get_return_object, so the coroutine might not be suspended yet.
+          st->suspended.wait(false, std::memory_order_acquire);
           std::move(h).resume();
         });
 
@@ -62,25 +126,38 @@ void run_thread(
     }
     BOOST_CATCH_END
 
-    st->done = true;
     st->signal.slot().clear();
-    std::lock_guard<std::mutex> lock(st->mtx);
-    if (!st->waitor && ep) // nobodies waiting, so unhandled exception
-      std::rethrow_exception(ep);
-    else if (st->waitor)
+    st->ep = ep;
+    auto prev = st->status.load(std::memory_order_acquire);
+    do
+    {
+      // an awaiter is emplacing its waitor.
+      while (prev == thread_state::registering)
+      {
+        st->status.wait(prev, std::memory_order_acquire);
+        prev = st->status.load(std::memory_order_acquire);
+      }
+    }
+    while (!st->status.compare_exchange_weak(prev, thread_state::finished,
+                                             std::memory_order_acq_rel, std::memory_order_acquire));
+
+    if (prev == thread_state::waiting)
       asio::post(asio::append(*std::exchange(st->waitor, std::nullopt), ep));
+    else if (ep) // nobodies waiting, so unhandled exception
+      std::rethrow_exception(ep);
   }
 }
 
 
 boost::cobalt::thread detail::thread_promise::get_return_object()
 {
-  auto st = std::make_shared<thread_state>();
+  auto st = std::make_shared<thread_state>(options_.concurrency_hint);
+  state_ = st.get();
   boost::cobalt::thread res{std::thread{
-      [st,
+      [st, opts = options_,
        h = unique_handle<detail::thread_promise>::from_promise(*this)]() mutable
       {
-        run_thread(std::move(st), std::move(h));
+        run_thread(std::move(st), std::move(h), opts);
       }
      }, st
     };
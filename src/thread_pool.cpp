@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/thread_pool.hpp>
+#include <boost/cobalt/this_thread.hpp>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace boost::cobalt
+{
+
+struct thread_pool::worker_
+{
+  explicit worker_(int concurrency_hint) : ctx{concurrency_hint} {}
+
+#if !defined(BOOST_COBALT_NO_PMR)
+  // declared before the io_context, so that handlers left over after stop() get freed into it.
+  pmr::unsynchronized_pool_resource resource;
+#endif
+  asio::io_context ctx;
+  std::optional<asio::executor_work_guard<asio::io_context::executor_type>> work{ctx.get_executor()};
+  std::thread thread;
+};
+
+thread_pool::thread_pool(std::size_t threads, const thread_options & opts)
+{
+  threads = (std::max)(threads, std::size_t(1u));
+  workers_.reserve(threads);
+  for (std::size_t i = 0u; i < threads; i++)
+    workers_.push_back(std::make_unique<worker_>(opts.concurrency_hint));
+
+  for (std::size_t i = 0u; i < threads; i++)
+  {
+    auto & w = *workers_[i];
+    auto o = opts;
+    if (!o.name.empty())
+      o.name += "-" + std::to_string(i);
+
+    w.thread = std::thread(
+        [&w, o = std::move(o)]
+        {
+          detail::apply_thread_options(o);
+#if !defined(BOOST_COBALT_NO_PMR)
+          this_thread::set_default_resource(&w.resource);
+#endif
+          this_thread::set_executor(w.ctx.get_executor());
+          w.ctx.run();
+        });
+  }
+}
+
+thread_pool::~thread_pool()
+{
+  stop();
+  join();
+}
+
+executor thread_pool::get_executor()
+{
+  return workers_[next_.fetch_add(1u, std::memory_order_relaxed) % workers_.size()]->ctx.get_executor();
+}
+
+executor thread_pool::get_executor(std::size_t idx) const
+{
+  return workers_[idx]->ctx.get_executor();
+}
+
+void thread_pool::stop()
+{
+  for (auto & w : workers_)
+    w->ctx.stop();
+}
+
+void thread_pool::join()
+{
+  for (auto & w : workers_)
+    w->work.reset();
+  for (auto & w : workers_)
+    if (w->thread.joinable())
+      w->thread.join();
+}
+
+}
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/as_completed.hpp>
+#include <boost/cobalt/task.hpp>
+
+#include <boost/asio/steady_timer.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+using namespace boost;
+
+namespace
+{
+
+std::size_t active = 0u, max_active = 0u;
+
+cobalt::task<int> delay(int ms)
+{
+  active++;
+  max_active = (std::max)(active, max_active);
+  asio::steady_timer tim{co_await cobalt::this_coro::executor, std::chrono::milliseconds(ms)};
+  co_await tim.async_wait(cobalt::use_op);
+  active--;
+  if (ms < 0)
+    throw std::runtime_error("negative");
+  co_return ms;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(as_completed_);
+
+CO_TEST_CASE(order)
+{
+  std::vector<cobalt::task<int>> vec;
+  vec.push_back(delay(30));
+  vec.push_back(delay(10));
+  vec.push_back(delay(20));
+
+  std::vector<std::size_t> order;
+  auto g = cobalt::as_completed(vec);
+  while (auto r = co_await g)
+  {
+    BOOST_CHECK(r->second.has_value());
+    order.push_back(r->first);
+  }
+  BOOST_CHECK((order == std::vector<std::size_t>{1u, 2u, 0u}));
+}
+
+CO_TEST_CASE(limit)
+{
+  active = max_active = 0u;
+  std::vector<cobalt::task<int>> vec;
+  for (int i = 0; i < 6; i++)
+    vec.push_back(delay(5 + i));
+
+  std::size_t cnt = 0u;
+  auto g = cobalt::as_completed(std::move(vec), 2u);
+  while (auto r = co_await g)
+  {
+    BOOST_CHECK(r->second.value() == 5 + static_cast<int>(r->first));
+    cnt++;
+  }
+  BOOST_CHECK(cnt == 6u);
+  BOOST_CHECK(max_active == 2u);
+}
+
+CO_TEST_CASE(exception)
+{
+  std::vector<cobalt::task<int>> vec;
+  vec.push_back(delay(-1));
+  vec.push_back(delay(1));
+
+  std::size_t errors = 0u;
+  auto g = cobalt::as_completed(vec, 1u);
+  while (auto r = co_await g)
+    if (r->second.has_error())
+    {
+      BOOST_CHECK(r->first == 0u);
+      BOOST_CHECK_THROW(std::rethrow_exception(r->second.error()), std::runtime_error);
+      errors++;
+    }
+  BOOST_CHECK(errors == 1u);
+}
+
+CO_TEST_CASE(empty)
+{
+  std::vector<cobalt::task<int>> vec;
+  auto g = cobalt::as_completed(vec);
+  BOOST_CHECK(!(co_await g));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
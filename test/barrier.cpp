@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/barrier.hpp>
+#include <boost/cobalt/channel.hpp>
+#include <boost/cobalt/promise.hpp>
+#include <boost/cobalt/race.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+#include <vector>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_SUITE(barrier);
+
+CO_TEST_CASE(phases)
+{
+  cobalt::barrier bar{3u};
+  std::vector<int> log;
+  auto worker = [&](int i) -> cobalt::promise<void>
+  {
+    for (int phase = 0; phase < 3; phase++)
+    {
+      log.push_back(phase * 10 + i);
+      co_await bar.arrive_and_wait();
+    }
+  };
+
+  auto w1 = worker(1), w2 = worker(2), w3 = worker(3);
+  co_await w1;
+  co_await w2;
+  co_await w3;
+  BOOST_CHECK(bar.phase() == 3u);
+  BOOST_REQUIRE(log.size() == 9u);
+  // no worker starts a phase before all finished the previous one.
+  for (std::size_t i = 0u; i < log.size(); i++)
+    BOOST_CHECK(log[i] / 10 == static_cast<int>(i / 3u));
+}
+
+CO_TEST_CASE(drop)
+{
+  cobalt::barrier bar{2u};
+  auto waiter = [&]() -> cobalt::promise<void>
+  {
+    co_await bar.arrive_and_wait();
+  };
+
+  auto p = waiter();
+  BOOST_CHECK(bar.arrived() == 1u);
+  bar.arrive_and_drop();
+  co_await p;
+  BOOST_CHECK(bar.expected() == 1u);
+  BOOST_CHECK(bar.phase() == 1u);
+  co_await bar.arrive_and_wait();
+  BOOST_CHECK(bar.phase() == 2u);
+}
+
+CO_TEST_CASE(cancel)
+{
+  cobalt::barrier bar{2u};
+  auto waiter = [&]() -> cobalt::promise<system::result<void>>
+  {
+    co_return co_await cobalt::as_result(bar.arrive_and_wait());
+  };
+
+  auto p = waiter();
+  BOOST_CHECK(bar.arrived() == 1u);
+  p.cancel();
+  BOOST_CHECK((co_await p).error() == asio::error::operation_aborted);
+  BOOST_CHECK(bar.arrived() == 0u);
+  BOOST_CHECK(bar.phase() == 0u);
+}
+
+CO_TEST_CASE(race_)
+{
+  cobalt::barrier bar{2u};
+  cobalt::channel<int> chn{1u};
+  co_await chn.write(42);
+
+  // the read is ready, so the arrival gets interrupted before it happened.
+  auto r = co_await cobalt::left_race(chn.read(), bar.arrive_and_wait());
+  BOOST_CHECK(r.index() == 0u);
+  BOOST_CHECK(bar.arrived() == 0u);
+
+  auto waiter = [&]() -> cobalt::promise<void>
+  {
+    co_await bar.arrive_and_wait();
+  };
+  auto p = waiter();
+  BOOST_CHECK(bar.arrived() == 1u);
+  co_await bar.arrive_and_wait();
+  co_await p;
+  BOOST_CHECK(bar.phase() == 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
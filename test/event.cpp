@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/event.hpp>
+#include <boost/cobalt/op.hpp>
+#include <boost/cobalt/promise.hpp>
+#include <boost/cobalt/race.hpp>
+
+#include <boost/asio/post.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+using namespace boost;
+
+BOOST_AUTO_TEST_SUITE(event);
+
+CO_TEST_CASE(manual_reset)
+{
+  cobalt::event evt;
+  int woken = 0;
+  auto waiter = [&]() -> cobalt::promise<void>
+  {
+    co_await evt.wait();
+    woken++;
+  };
+
+  auto p1 = waiter(), p2 = waiter(), p3 = waiter();
+  BOOST_CHECK(woken == 0);
+  evt.set();
+  BOOST_CHECK(evt.is_set());
+  co_await p1;
+  co_await p2;
+  co_await p3;
+  BOOST_CHECK(woken == 3);
+
+  // stays set.
+  co_await evt.wait();
+  evt.reset();
+  BOOST_CHECK(!evt.is_set());
+}
+
+CO_TEST_CASE(auto_reset)
+{
+  cobalt::event evt{cobalt::event::auto_reset};
+  int woken = 0;
+  auto waiter = [&]() -> cobalt::promise<void>
+  {
+    co_await evt.wait();
+    woken++;
+  };
+
+  auto p1 = waiter(), p2 = waiter();
+  evt.set();
+  BOOST_CHECK(!evt.is_set());
+  co_await p1;
+  BOOST_CHECK(woken == 1);
+  evt.set();
+  co_await p2;
+  BOOST_CHECK(woken == 2);
+
+  // no waiter, so it gets consumed by the next wait.
+  evt.set();
+  BOOST_CHECK(evt.is_set());
+  co_await evt.wait();
+  BOOST_CHECK(!evt.is_set());
+}
+
+CO_TEST_CASE(cancel)
+{
+  cobalt::event evt;
+  auto waiter = [&]() -> cobalt::promise<system::result<void>>
+  {
+    co_return co_await cobalt::as_result(evt.wait());
+  };
+
+  auto p1 = waiter(), p2 = waiter();
+  p1.cancel();
+  BOOST_CHECK((co_await p1).error() == asio::error::operation_aborted);
+  evt.set();
+  BOOST_CHECK((co_await p2).has_value());
+}
+
+CO_TEST_CASE(interrupt)
+{
+  cobalt::event evt;
+  auto r = co_await cobalt::left_race(evt.wait(), asio::post(cobalt::use_op));
+  BOOST_CHECK(r.index() == 1u);
+  evt.set();
+  r = co_await cobalt::left_race(evt.wait(), asio::post(cobalt::use_op));
+  BOOST_CHECK(r.index() == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/hedge.hpp>
+#include <boost/cobalt/promise.hpp>
+#include <boost/cobalt/op.hpp>
+
+#include <boost/asio/steady_timer.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+using namespace boost;
+
+// a negative duration throws
+static cobalt::promise<int> attempt(std::chrono::milliseconds ms, bool & cancelled)
+try
+{
+  if (ms.count() < 0)
+    throw std::runtime_error("attempt");
+  asio::steady_timer tim{co_await cobalt::this_coro::executor, ms};
+  co_await tim.async_wait(cobalt::use_op);
+  co_return static_cast<int>(ms.count());
+}
+catch (system::system_error & se)
+{
+  cancelled = se.code() == asio::error::operation_aborted;
+  throw;
+}
+
+BOOST_AUTO_TEST_SUITE(hedge_);
+
+CO_TEST_CASE(first_wins)
+{
+  std::size_t calls = 0u;
+  bool cancelled = false;
+  auto [idx, res] = co_await cobalt::hedge(
+      [&]{calls++; return attempt(std::chrono::milliseconds(5), cancelled);},
+      std::chrono::milliseconds(100));
+  BOOST_CHECK(idx == 0u);
+  BOOST_CHECK(res == 5);
+  BOOST_CHECK(calls == 1u);
+}
+
+CO_TEST_CASE(hedged)
+{
+  const std::chrono::milliseconds durations[] = {std::chrono::milliseconds(100000), std::chrono::milliseconds(10)};
+  std::size_t calls = 0u;
+  bool cancelled = false;
+  auto [idx, res] = co_await cobalt::hedge(
+      [&]{return attempt(durations[calls++], cancelled);},
+      std::chrono::milliseconds(10));
+  BOOST_CHECK(idx == 1u);
+  BOOST_CHECK(res == 10);
+  BOOST_CHECK(calls == 2u);
+  BOOST_CHECK(cancelled);
+}
+
+CO_TEST_CASE(failed)
+{
+  const std::chrono::milliseconds durations[] = {std::chrono::milliseconds(-1), std::chrono::milliseconds(1)};
+  std::size_t calls = 0u;
+  bool cancelled = false;
+  const auto start = std::chrono::steady_clock::now();
+  auto [idx, res] = co_await cobalt::hedge(
+      [&]{return attempt(durations[calls++], cancelled);},
+      std::chrono::seconds(10));
+  // the failure started the next attempt right away.
+  BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+  BOOST_CHECK(idx == 1u);
+  BOOST_CHECK(res == 1);
+}
+
+CO_TEST_CASE(all_failed)
+{
+  std::size_t calls = 0u;
+  bool cancelled = false;
+  BOOST_CHECK_THROW(
+      co_await cobalt::hedge(
+          [&]{calls++; return attempt(std::chrono::milliseconds(-1), cancelled);},
+          std::chrono::milliseconds(10), 3u),
+      std::runtime_error);
+  BOOST_CHECK(calls == 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
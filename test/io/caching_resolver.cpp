@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/io/caching_resolver.hpp>
+#include <boost/cobalt/join.hpp>
+#include <boost/cobalt/result.hpp>
+
+#include <boost/asio/append.hpp>
+#include <boost/asio/post.hpp>
+
+#include "../test.hpp"
+
+using namespace boost;
+
+namespace
+{
+
+// completes asynchronously, 10.0.0.x for every host, but fails for "missing".
+struct test_backend final : cobalt::io::resolver_backend
+{
+  std::size_t calls = 0u;
+
+  cobalt::io::resolve_op resolve(std::string_view host, std::string_view service) override
+  {
+    return {host, service, this, &initiate_};
+  }
+
+  static void initiate_(void * this_, std::string_view host, std::string_view,
+                        cobalt::completion_handler<system::error_code, cobalt::io::endpoint_sequence> h)
+  {
+    auto & self = *static_cast<test_backend*>(this_);
+    self.calls++;
+    cobalt::io::endpoint_sequence res;
+    system::error_code ec;
+    if (host == "missing")
+      ec = asio::error::host_not_found;
+    else
+      res.emplace_back(cobalt::io::tcp_v4, "10.0.0." + std::to_string(self.calls), std::uint16_t(80));
+    asio::post(asio::append(std::move(h), ec, std::move(res)));
+  }
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(caching_resolver);
+
+CO_TEST_CASE(coalesce)
+{
+  test_backend backend;
+  cobalt::io::caching_resolver res{backend};
+
+  auto [r1, r2] = co_await cobalt::join(res.resolve("boost.org", "http"), res.resolve("boost.org", "http"));
+  BOOST_CHECK_EQUAL(backend.calls, 1u);
+  BOOST_REQUIRE_EQUAL(r1.size(), 1u);
+  BOOST_REQUIRE_EQUAL(r2.size(), 1u);
+  BOOST_CHECK(cobalt::io::get<cobalt::io::tcp_v4>(r1[0]).addr_str() == "10.0.0.1");
+  BOOST_CHECK(cobalt::io::get<cobalt::io::tcp_v4>(r2[0]).addr_str() == "10.0.0.1");
+
+  auto r3 = co_await res.resolve("boost.org", "http");
+  BOOST_CHECK_EQUAL(backend.calls, 1u);
+  BOOST_CHECK(cobalt::io::get<cobalt::io::tcp_v4>(r3[0]).addr_str() == "10.0.0.1");
+
+  co_await res.resolve("boost.org", "https");
+  BOOST_CHECK_EQUAL(backend.calls, 2u);
+  BOOST_CHECK_EQUAL(res.size(), 2u);
+}
+
+CO_TEST_CASE(ttl)
+{
+  test_backend backend;
+  cobalt::io::caching_resolver res{backend};
+  res.ttl = std::chrono::steady_clock::duration::zero();
+
+  co_await res.resolve("boost.org", "http");
+  auto r = co_await res.resolve("boost.org", "http");
+  BOOST_CHECK_EQUAL(backend.calls, 2u);
+  BOOST_CHECK(cobalt::io::get<cobalt::io::tcp_v4>(r[0]).addr_str() == "10.0.0.2");
+
+  res.ttl = std::chrono::hours(1);
+  co_await res.resolve("boost.org", "http");
+  co_await res.resolve("boost.org", "http");
+  BOOST_CHECK_EQUAL(backend.calls, 3u);
+
+  res.erase("boost.org", "http");
+  co_await res.resolve("boost.org", "http");
+  BOOST_CHECK_EQUAL(backend.calls, 4u);
+}
+
+CO_TEST_CASE(negative)
+{
+  test_backend backend;
+  cobalt::io::caching_resolver res{backend};
+
+  auto r1 = co_await cobalt::as_result(res.resolve("missing", "http"));
+  auto r2 = co_await cobalt::as_result(res.resolve("missing", "http"));
+  BOOST_CHECK(r1.error() == asio::error::host_not_found);
+  BOOST_CHECK(r2.error() == asio::error::host_not_found);
+  BOOST_CHECK_EQUAL(backend.calls, 1u);
+
+  res.clear();
+  BOOST_CHECK_EQUAL(res.size(), 0u);
+  co_await cobalt::as_result(res.resolve("missing", "http"));
+  BOOST_CHECK_EQUAL(backend.calls, 2u);
+}
+
+CO_TEST_CASE(max_entries)
+{
+  test_backend backend;
+  cobalt::io::caching_resolver res{backend};
+  res.max_entries = 4u;
+
+  for (int i = 0; i < 10; i++)
+  {
+    co_await res.resolve("host" + std::to_string(i) + ".boost.org", "http");
+    BOOST_CHECK_LE(res.size(), 4u);
+  }
+  BOOST_CHECK_EQUAL(backend.calls, 10u);
+
+  // the latest one is still cached
+  co_await res.resolve("host9.boost.org", "http");
+  BOOST_CHECK_EQUAL(backend.calls, 10u);
+}
+
+CO_TEST_CASE(hosts)
+{
+  test_backend backend;
+  cobalt::io::caching_resolver res{backend};
+
+  BOOST_CHECK(res.load_hosts("# static entries\n"
+                             "127.0.0.1   localhost  boost.test # comment\n"
+                             "\n"
+                             "::1 ip6-localhost boost.test\r\n"));
+  BOOST_CHECK(res.add_host("foo", "not an address").has_error());
+
+  auto r = co_await res.resolve("boost.test", "8080");
+  BOOST_CHECK_EQUAL(backend.calls, 0u);
+  BOOST_REQUIRE_EQUAL(r.size(), 2u);
+  BOOST_CHECK(cobalt::io::get<cobalt::io::ip>(r[0]).addr_str() == "127.0.0.1");
+  BOOST_CHECK_EQUAL(cobalt::io::get<cobalt::io::ip>(r[0]).port(), 8080u);
+  BOOST_CHECK(cobalt::io::get<cobalt::io::ip>(r[1]).is_ipv6());
+  BOOST_CHECK_EQUAL(cobalt::io::get<cobalt::io::ip>(r[1]).port(), 8080u);
+
+  // named services get looked up in the services database.
+  r = co_await res.resolve("localhost", "http");
+  BOOST_REQUIRE_EQUAL(r.size(), 1u);
+  BOOST_CHECK_EQUAL(cobalt::io::get<cobalt::io::ip>(r[0]).port(), 80u);
+
+  auto e = co_await cobalt::as_result(res.resolve("localhost", "no-such-service"));
+  BOOST_CHECK(e.error() == asio::error::service_not_found);
+  BOOST_CHECK_EQUAL(backend.calls, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
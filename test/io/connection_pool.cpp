@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/io/acceptor.hpp>
+#include <boost/cobalt/io/connection_pool.hpp>
+#include <boost/cobalt/io/sleep.hpp>
+#include <boost/cobalt/io/stream_socket.hpp>
+#include <boost/cobalt/promise.hpp>
+
+#include <boost/asio/ip/tcp.hpp>
+
+#include "../test.hpp"
+
+using namespace boost;
+
+namespace
+{
+
+cobalt::io::endpoint loopback(unsigned short port)
+{
+  return asio::ip::tcp::endpoint(asio::ip::make_address_v4("127.0.0.1"), port);
+}
+
+cobalt::promise<cobalt::io::connection_pool::lease> acquire(cobalt::io::connection_pool & pool, cobalt::io::endpoint ep)
+{
+  co_return co_await pool.acquire(ep);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(connection_pool_);
+
+CO_TEST_CASE(reuse)
+{
+  cobalt::io::acceptor acc{loopback(0)};
+  const auto ep = acc.local_endpoint();
+  cobalt::io::connection_pool pool;
+
+  auto l1 = co_await pool.acquire(ep);
+  BOOST_REQUIRE(l1);
+  BOOST_CHECK(!l1.reused());
+  BOOST_CHECK(l1.socket() != nullptr);
+  auto srv = co_await acc.accept();
+  auto s1 = &l1.get<cobalt::io::stream_socket>();
+  l1.release();
+  BOOST_CHECK_EQUAL(pool.idle(), 1u);
+  BOOST_CHECK_EQUAL(pool.size(), 1u);
+
+  auto l2 = co_await pool.acquire(ep);
+  BOOST_CHECK(l2.reused());
+  BOOST_CHECK(&l2.get<cobalt::io::stream_socket>() == s1);
+  BOOST_CHECK_EQUAL(pool.idle(), 0u);
+
+  l2.discard();
+  l2.release();
+  BOOST_CHECK_EQUAL(pool.size(), 0u);
+}
+
+CO_TEST_CASE(closed_by_peer)
+{
+  cobalt::io::acceptor acc{loopback(0)};
+  const auto ep = acc.local_endpoint();
+  cobalt::io::connection_pool pool;
+
+  {
+    auto l = co_await pool.acquire(ep);
+    auto srv = co_await acc.accept();
+    BOOST_CHECK(srv.close());
+    co_await cobalt::io::sleep(std::chrono::milliseconds(10));
+  }
+  BOOST_CHECK_EQUAL(pool.idle(), 1u);
+
+  auto l = co_await pool.acquire(ep);
+  BOOST_CHECK(!l.reused());
+  BOOST_CHECK_EQUAL(pool.size(), 1u);
+}
+
+CO_TEST_CASE(idle_timeout)
+{
+  cobalt::io::acceptor acc{loopback(0)};
+  const auto ep = acc.local_endpoint();
+  cobalt::io::connection_pool pool;
+  pool.idle_timeout = std::chrono::milliseconds(1);
+
+  (co_await pool.acquire(ep)).release();
+  co_await cobalt::io::sleep(std::chrono::milliseconds(5));
+  pool.purge();
+  BOOST_CHECK_EQUAL(pool.size(), 0u);
+}
+
+CO_TEST_CASE(fifo)
+{
+  cobalt::io::acceptor acc{loopback(0)};
+  const auto ep = acc.local_endpoint();
+  cobalt::io::connection_pool pool;
+  pool.max_total = 1u;
+
+  auto l1 = co_await pool.acquire(ep);
+  auto p1 = acquire(pool, ep);
+  auto p2 = acquire(pool, ep);
+  co_await cobalt::io::sleep(std::chrono::milliseconds(1));
+  BOOST_CHECK(!p1.ready());
+  BOOST_CHECK(!p2.ready());
+
+  l1.release();
+  auto l2 = co_await p1;
+  BOOST_CHECK(l2.reused());
+  BOOST_CHECK(!p2.ready());
+
+  // a discarded connection passes on the slot, so the next waiter connects.
+  l2.discard();
+  l2.release();
+  auto l3 = co_await p2;
+  BOOST_REQUIRE(l3);
+  BOOST_CHECK(!l3.reused());
+  BOOST_CHECK_EQUAL(pool.size(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,65 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "../test.hpp"
+
+#include <boost/cobalt/io/copy_range.hpp>
+#include <boost/cobalt/result.hpp>
+
+#if !defined(BOOST_ASIO_WINDOWS)
+
+#include <cstdio>
+#include <unistd.h>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_SUITE(copy_range_);
+
+CO_TEST_CASE(copy)
+{
+  std::FILE * src = std::tmpfile();
+  std::FILE * dst = std::tmpfile();
+  BOOST_REQUIRE(src != nullptr);
+  BOOST_REQUIRE(dst != nullptr);
+
+  std::string data;
+  data.resize(300000u);
+  for (std::size_t i = 0u; i < data.size(); i++)
+    data[i] = static_cast<char>(i % 251);
+  BOOST_REQUIRE(std::fwrite(data.data(), 1, data.size(), src) == data.size());
+  std::fflush(src);
+
+  cobalt::io::random_access_file s{::dup(fileno(src))};
+  cobalt::io::random_access_file d{::dup(fileno(dst))};
+
+  std::uint64_t last = 0u;
+  std::size_t calls = 0u;
+  auto progress = [&](std::uint64_t n) {BOOST_CHECK(n > last); last = n; calls++;};
+  auto cr = cobalt::io::copy_range(s, 1000u, d, 10u, 200000u, progress);
+  cr.chunk_size = 65536u;
+  auto n = co_await cr;
+  BOOST_CHECK_EQUAL(n, 200000u);
+  BOOST_CHECK_EQUAL(last, 200000u);
+  BOOST_CHECK_GE(calls, 4u);
+
+  std::string result;
+  result.resize(200000u);
+  BOOST_REQUIRE(::pread(fileno(dst), result.data(), result.size(), 10) == static_cast<ssize_t>(result.size()));
+  BOOST_CHECK(result == data.substr(1000u, 200000u));
+
+  // reading past the end
+  auto [ec, m] = co_await cobalt::as_tuple(cobalt::io::copy_range(s, 299000u, d, 0u, 2000u));
+  BOOST_CHECK(ec == asio::error::eof);
+  BOOST_CHECK_EQUAL(m, 1000u);
+
+  std::fclose(src);
+  std::fclose(dst);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+#endif
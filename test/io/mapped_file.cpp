@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "../test.hpp"
+
+#include <boost/cobalt/io/mapped_file.hpp>
+
+#if !defined(BOOST_ASIO_WINDOWS)
+
+#include <cstdio>
+#include <string_view>
+
+#include <unistd.h>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_SUITE(mapped_file_);
+
+CO_TEST_CASE(view)
+{
+  std::FILE * fp = std::tmpfile();
+  BOOST_REQUIRE(fp != nullptr);
+  std::string data(10000, 'x');
+  data.replace(5000, 13, "Hello, World!");
+  BOOST_REQUIRE(std::fwrite(data.data(), 1, data.size(), fp) == data.size());
+  std::fflush(fp);
+
+  cobalt::io::mapped_file mf;
+  BOOST_CHECK(!mf.is_mapped());
+  BOOST_REQUIRE(mf.map(fileno(fp), 4999, cobalt::io::mapped_file::npos,
+                       cobalt::io::mapped_file::read_only,
+                       cobalt::io::mapped_file::populate | cobalt::io::mapped_file::random));
+  BOOST_CHECK(mf.is_mapped());
+  BOOST_CHECK_EQUAL(mf.offset(), 4999u);
+  BOOST_CHECK_EQUAL(mf.size(), 5001u);
+
+  auto v = mf.view(1, 13);
+  BOOST_CHECK(std::string_view(v.data(), v.size()) == "Hello, World!");
+  BOOST_CHECK(mf.view(5000, 100).size() == 1u);
+  BOOST_CHECK(mf.view(6000).empty());
+
+  co_await mf.prefetch();
+  co_await mf.prefetch(10, 0);
+
+  auto mv = std::move(mf);
+  BOOST_CHECK(!mf.is_mapped());
+  BOOST_CHECK(mv.is_mapped());
+  BOOST_CHECK(mv.unmap());
+  BOOST_CHECK(!mv.is_mapped());
+
+  BOOST_CHECK(mf.map(fileno(fp), 20000).has_error());
+  std::fclose(fp);
+}
+
+CO_TEST_CASE(write)
+{
+  std::FILE * fp = std::tmpfile();
+  BOOST_REQUIRE(fp != nullptr);
+  std::string data(100, 'x');
+  BOOST_REQUIRE(std::fwrite(data.data(), 1, data.size(), fp) == data.size());
+  std::fflush(fp);
+
+  {
+    cobalt::io::mapped_file mf;
+    BOOST_REQUIRE(mf.map(fileno(fp), 0, 50, cobalt::io::mapped_file::read_write));
+    BOOST_CHECK_EQUAL(mf.size(), 50u);
+    mf.mutable_view(10, 3)[1] = 'y';
+    BOOST_CHECK(mf.flush(false));
+  }
+
+  char buf[3];
+  BOOST_REQUIRE(::pread(fileno(fp), buf, 3, 10) == 3);
+  BOOST_CHECK(std::string_view(buf, 3) == "xyx");
+  std::fclose(fp);
+  co_return;
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+#endif
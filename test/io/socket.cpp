@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "../test.hpp"
+
+#include <boost/cobalt/io/acceptor.hpp>
+#include <boost/cobalt/io/stream_socket.hpp>
+#include <boost/cobalt/result.hpp>
+
+#include <boost/asio/ip/tcp.hpp>
+
+using namespace boost;
+
+namespace
+{
+
+cobalt::io::endpoint loopback(unsigned short port)
+{
+  return asio::ip::tcp::endpoint(asio::ip::make_address_v4("127.0.0.1"), port);
+}
+
+// a port nobody is listening on.
+unsigned short closed_port()
+{
+  cobalt::io::acceptor acc{loopback(0)};
+  return get<cobalt::io::tcp>(acc.local_endpoint()).port();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(socket_);
+
+CO_TEST_CASE(staggered_connect)
+{
+  cobalt::io::acceptor acc{loopback(0)};
+  const auto port = get<cobalt::io::tcp>(acc.local_endpoint()).port();
+  const auto closed = closed_port();
+
+  cobalt::io::endpoint_sequence eps;
+  eps.push_back(loopback(closed));
+  eps.push_back(loopback(port));
+
+  cobalt::io::stream_socket sock;
+  auto ep = co_await sock.connect(eps, std::chrono::milliseconds(50));
+  BOOST_CHECK_EQUAL(get<cobalt::io::tcp>(ep).port(), port);
+  BOOST_CHECK(sock.is_open());
+  BOOST_CHECK_EQUAL(get<cobalt::io::tcp>(sock.remote_endpoint().value()).port(), port);
+}
+
+CO_TEST_CASE(staggered_connect_fail)
+{
+  cobalt::io::endpoint_sequence eps;
+  eps.push_back(loopback(closed_port()));
+  eps.push_back(loopback(closed_port()));
+
+  cobalt::io::stream_socket sock;
+  auto [ec, ep] = co_await cobalt::as_tuple(sock.connect(eps, std::chrono::milliseconds(50)));
+  BOOST_CHECK(ec == asio::error::connection_refused);
+  BOOST_CHECK(!sock.is_open());
+}
+
+CO_TEST_CASE(staggered_connect_empty)
+{
+  cobalt::io::stream_socket sock;
+  auto [ec, ep] = co_await cobalt::as_tuple(sock.connect(cobalt::io::endpoint_sequence{}, std::chrono::milliseconds(50)));
+  BOOST_CHECK(ec == asio::error::host_not_found);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
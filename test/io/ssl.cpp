@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/io/acceptor.hpp>
+#include <boost/cobalt/io/read.hpp>
+#include <boost/cobalt/io/ssl.hpp>
+#include <boost/cobalt/io/stream_socket.hpp>
+#include <boost/cobalt/io/write.hpp>
+#include <boost/cobalt/join.hpp>
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <array>
+
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+#include "../test.hpp"
+
+using namespace boost;
+
+namespace
+{
+
+cobalt::io::endpoint loopback(unsigned short port)
+{
+  return asio::ip::tcp::endpoint(asio::ip::make_address_v4("127.0.0.1"), port);
+}
+
+// a self signed certificate, so the test doesn't need any files.
+void use_test_certificate(cobalt::io::ssl::context & ctx)
+{
+  EVP_PKEY * key = nullptr;
+  auto kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+  BOOST_REQUIRE(kctx != nullptr);
+  BOOST_REQUIRE(EVP_PKEY_keygen_init(kctx) == 1);
+  BOOST_REQUIRE(EVP_PKEY_CTX_set_ec_paramgen_curve_nid(kctx, NID_X9_62_prime256v1) == 1);
+  BOOST_REQUIRE(EVP_PKEY_keygen(kctx, &key) == 1);
+  EVP_PKEY_CTX_free(kctx);
+
+  auto cert = X509_new();
+  X509_set_version(cert, 2);
+  ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+  X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+  X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+  X509_set_pubkey(cert, key);
+  auto name = X509_get_subject_name(cert);
+  X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+  X509_set_issuer_name(cert, name);
+  BOOST_REQUIRE(X509_sign(cert, key, EVP_sha256()) > 0);
+
+  BOOST_REQUIRE(SSL_CTX_use_certificate(ctx.native_handle(), cert) == 1);
+  BOOST_REQUIRE(SSL_CTX_use_PrivateKey(ctx.native_handle(), key) == 1);
+  X509_free(cert);
+  EVP_PKEY_free(key);
+}
+
+// connect, handshake & exchange some data, so the client receives the tls 1.3 session tickets.
+cobalt::promise<bool> connect(cobalt::io::acceptor & acc,
+                              cobalt::io::ssl::context & server_ctx,
+                              cobalt::io::ssl::context & client_ctx)
+{
+  cobalt::io::ssl::stream client{client_ctx};
+  co_await client.connect(acc.local_endpoint());
+  BOOST_CHECK(client.set_server_name("localhost"));
+  cobalt::io::ssl::stream server{server_ctx, co_await acc.accept()};
+
+  co_await cobalt::join(server.handshake(cobalt::io::ssl::stream::server), client.handshake(cobalt::io::ssl::stream::client));
+  BOOST_CHECK(client.secure());
+  BOOST_CHECK(server.secure());
+
+  char buf[4];
+  co_await cobalt::join(cobalt::io::write(server, cobalt::io::buffer("ping", 4u)),
+                        client.read_some(cobalt::io::buffer(buf)));
+  co_return client.resumed();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ssl_);
+
+CO_TEST_CASE(session_cache)
+{
+  cobalt::io::acceptor acc{loopback(0)};
+  cobalt::io::ssl::context server_ctx{cobalt::io::ssl::context::tls_server};
+  use_test_certificate(server_ctx);
+
+  cobalt::io::ssl::context client_ctx{cobalt::io::ssl::context::tls_client};
+  cobalt::io::ssl::session_cache cache;
+  BOOST_REQUIRE(cache.attach(client_ctx));
+
+  BOOST_CHECK(!co_await connect(acc, server_ctx, client_ctx));
+  BOOST_CHECK_GE(cache.size(), 1u);
+  BOOST_CHECK(co_await connect(acc, server_ctx, client_ctx));
+  BOOST_CHECK(co_await connect(acc, server_ctx, client_ctx));
+
+  // the tickets from before can't be decrypted anymore.
+  BOOST_CHECK(cobalt::io::ssl::rotate_ticket_keys(server_ctx));
+  BOOST_CHECK(!co_await connect(acc, server_ctx, client_ctx));
+  BOOST_CHECK(co_await connect(acc, server_ctx, client_ctx));
+
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.size(), 0u);
+  BOOST_CHECK(!co_await connect(acc, server_ctx, client_ctx));
+}
+
+CO_TEST_CASE(session_cache_tls12)
+{
+  cobalt::io::acceptor acc{loopback(0)};
+  cobalt::io::ssl::context server_ctx{cobalt::io::ssl::context::tls_server};
+  use_test_certificate(server_ctx);
+
+  cobalt::io::ssl::context client_ctx{cobalt::io::ssl::context::tls_client};
+  BOOST_REQUIRE(SSL_CTX_set_max_proto_version(client_ctx.native_handle(), TLS1_2_VERSION) == 1);
+  cobalt::io::ssl::session_cache cache;
+  BOOST_REQUIRE(cache.attach(client_ctx));
+
+  BOOST_CHECK(!co_await connect(acc, server_ctx, client_ctx));
+  // a resumed tls 1.2 session doesn't get a new one, so it needs to stay in the cache.
+  BOOST_CHECK(co_await connect(acc, server_ctx, client_ctx));
+  BOOST_CHECK(co_await connect(acc, server_ctx, client_ctx));
+  BOOST_CHECK(co_await connect(acc, server_ctx, client_ctx));
+  BOOST_CHECK_EQUAL(cache.size(), 1u);
+}
+
+CO_TEST_CASE(offload_handshake)
+{
+  cobalt::io::acceptor acc{loopback(0)};
+  cobalt::io::ssl::context server_ctx{cobalt::io::ssl::context::tls_server};
+  use_test_certificate(server_ctx);
+  cobalt::io::ssl::context client_ctx{cobalt::io::ssl::context::tls_client};
+  asio::thread_pool pool{2u};
+
+  cobalt::io::ssl::stream client{client_ctx};
+  client.set_handshake_executor(pool.get_executor());
+  co_await client.connect(acc.local_endpoint());
+  cobalt::io::ssl::stream server{server_ctx, co_await acc.accept()};
+  server.set_handshake_executor(pool.get_executor());
+
+  co_await cobalt::join(server.handshake(cobalt::io::ssl::stream::server),
+                        client.handshake(cobalt::io::ssl::stream::client));
+  BOOST_CHECK(client.secure());
+  BOOST_CHECK(server.secure());
+
+  char buf[4];
+  co_await cobalt::join(cobalt::io::write(client, cobalt::io::buffer("ping", 4u)),
+                        cobalt::io::read(server, cobalt::io::buffer(buf)));
+  BOOST_CHECK(std::string_view(buf, 4u) == "ping");
+}
+
+CO_TEST_CASE(record_sizing)
+{
+  cobalt::io::acceptor acc{loopback(0)};
+  cobalt::io::ssl::context server_ctx{cobalt::io::ssl::context::tls_server};
+  use_test_certificate(server_ctx);
+  cobalt::io::ssl::context client_ctx{cobalt::io::ssl::context::tls_client};
+
+  cobalt::io::ssl::stream client{client_ctx};
+  co_await client.connect(acc.local_endpoint());
+  cobalt::io::ssl::stream server{server_ctx, co_await acc.accept()};
+  co_await cobalt::join(server.handshake(cobalt::io::ssl::stream::server),
+                        client.handshake(cobalt::io::ssl::stream::client));
+
+  // small buffers get coalesced into one small record.
+  std::array<std::string, 256u> messages;
+  std::array<cobalt::io::const_buffer, 256u> buffers;
+  std::string expected;
+  for (std::size_t i = 0u; i < messages.size(); i++)
+  {
+    messages[i] = "message-" + std::to_string(i) + "\n";
+    buffers[i] = cobalt::io::buffer(messages[i]);
+    expected += messages[i];
+  }
+
+  auto n = co_await client.write_some(buffers);
+  BOOST_CHECK_GT(n, messages[0].size());
+  BOOST_CHECK_LE(n, client.small_record_size);
+
+  std::string received(n, '\0');
+  co_await cobalt::io::read(server, cobalt::io::buffer(received));
+  BOOST_CHECK(received == expected.substr(0u, n));
+
+  // full records once boosted.
+  client.record_boost_threshold = 0u;
+  std::string large(100000u, 'x');
+  n = co_await client.write_some(cobalt::io::buffer(large));
+  BOOST_CHECK_EQUAL(n, cobalt::io::ssl::stream::max_record_size);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/ipc_channel.hpp>
+
+#if defined(__linux__)
+
+#include <boost/cobalt/promise.hpp>
+#include <boost/cobalt/result.hpp>
+#include <boost/cobalt/run.hpp>
+
+#include <boost/asio/io_context.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace boost;
+
+namespace
+{
+
+struct message
+{
+  int idx;
+  double value;
+};
+
+constexpr int message_count = 100'000;
+
+cobalt::task<void> write_all(cobalt::ipc_ring & ring)
+{
+  cobalt::ipc_channel<message> chan{ring, co_await cobalt::this_coro::executor};
+  chan.spin = 64u;
+  for (int i = 0; i < message_count; i++)
+    co_await chan.write(message{i, i * 0.5});
+  chan.close();
+}
+
+cobalt::task<int> read_all(cobalt::ipc_ring & ring)
+{
+  cobalt::ipc_channel<message> chan{ring, co_await cobalt::this_coro::executor};
+  int expected = 0;
+  while (true)
+  {
+    auto res = co_await cobalt::as_result(chan.read());
+    if (res.has_error())
+    {
+      BOOST_CHECK(res.error() == asio::error::broken_pipe);
+      break;
+    }
+    // in order & complete
+    if (res->idx != expected || res->value != expected * 0.5)
+      co_return -1;
+    expected++;
+  }
+  co_return expected;
+}
+
+cobalt::promise<void> write_some(cobalt::ipc_channel<int> & chan, int n)
+{
+  for (int i = 0; i < n; i++)
+    co_await chan.write(i);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ipc_channel);
+
+CO_TEST_CASE(local)
+{
+  auto ring = cobalt::ipc_ring::create<int>(4u).value();
+  BOOST_CHECK(ring.capacity() == 4u);
+  cobalt::ipc_channel<int> writer{ring};
+  cobalt::ipc_channel<int> reader{ring};
+
+  // more than the capacity, so the writer has to wait for the reader.
+  auto p = write_some(writer, 10);
+  for (int i = 0; i < 10; i++)
+    BOOST_CHECK(co_await reader.read() == i);
+  co_await p;
+
+  co_await writer.write(42);
+  writer.close();
+  BOOST_CHECK(!reader.is_open());
+  // still drained after close
+  BOOST_CHECK(co_await reader.read() == 42);
+  BOOST_CHECK_THROW(co_await reader.read(), boost::system::system_error);
+  BOOST_CHECK_THROW(co_await writer.write(1), boost::system::system_error);
+}
+
+BOOST_AUTO_TEST_CASE(element_size)
+{
+  auto ring = cobalt::ipc_ring::create<int>(4u).value();
+  asio::io_context ctx;
+  BOOST_CHECK_THROW(cobalt::ipc_channel<message>(ring, ctx.get_executor()), boost::system::system_error);
+}
+
+BOOST_AUTO_TEST_CASE(fork)
+{
+  auto ring = cobalt::ipc_ring::create<message>(64u).value();
+
+  const pid_t pid = ::fork();
+  BOOST_REQUIRE(pid != -1);
+  if (pid == 0)
+  {
+    int code = 0;
+    try
+    {
+      cobalt::run(write_all(ring));
+    }
+    catch (...)
+    {
+      code = 1;
+    }
+    ::_exit(code);
+  }
+
+  const int received = cobalt::run(read_all(ring));
+  int status = 0;
+  ::waitpid(pid, &status, 0);
+  BOOST_CHECK(WIFEXITED(status));
+  BOOST_CHECK_EQUAL(WEXITSTATUS(status), 0);
+  BOOST_CHECK_EQUAL(received, message_count);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+#endif
@@ -0,0 +1,63 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/latch.hpp>
+#include <boost/cobalt/promise.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+#include <vector>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_SUITE(latch);
+
+CO_TEST_CASE(start_together)
+{
+  cobalt::latch ltc{4u};
+  int started = 0;
+  auto client = [&]() -> cobalt::promise<void>
+  {
+    co_await ltc.arrive_and_wait();
+    started++;
+  };
+
+  std::vector<cobalt::promise<void>> clients;
+  for (int i = 0; i < 3; i++)
+    clients.push_back(client());
+  BOOST_CHECK(ltc.count() == 1u);
+  BOOST_CHECK(!ltc.try_wait());
+  BOOST_CHECK(started == 0);
+
+  co_await ltc.arrive_and_wait();
+  BOOST_CHECK(ltc.try_wait());
+  for (auto & c : clients)
+    co_await c;
+  BOOST_CHECK(started == 3);
+
+  // stays open
+  co_await ltc.wait();
+  ltc.count_down();
+  BOOST_CHECK(ltc.count() == 0u);
+}
+
+CO_TEST_CASE(cancel)
+{
+  cobalt::latch ltc{1u};
+  auto waiter = [&]() -> cobalt::promise<system::result<void>>
+  {
+    co_return co_await cobalt::as_result(ltc.wait());
+  };
+
+  auto p = waiter();
+  p.cancel();
+  BOOST_CHECK((co_await p).error() == asio::error::operation_aborted);
+  BOOST_CHECK(ltc.count() == 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
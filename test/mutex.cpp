@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/mutex.hpp>
+#include <boost/cobalt/op.hpp>
+#include <boost/cobalt/promise.hpp>
+#include <boost/cobalt/race.hpp>
+
+#include <boost/asio/post.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+#include <vector>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_SUITE(mutex);
+
+CO_TEST_CASE(uncontended)
+{
+  cobalt::mutex mtx;
+  BOOST_CHECK(!mtx.is_locked());
+  co_await mtx.lock();
+  BOOST_CHECK(mtx.is_locked());
+  BOOST_CHECK(!mtx.try_lock());
+  mtx.unlock();
+  BOOST_CHECK(mtx.try_lock());
+  mtx.unlock();
+  BOOST_CHECK(!mtx.is_locked());
+}
+
+CO_TEST_CASE(fifo)
+{
+  cobalt::mutex mtx;
+  std::vector<int> order;
+  auto locker = [&](int i) -> cobalt::promise<void>
+  {
+    co_await mtx.lock();
+    order.push_back(i);
+    mtx.unlock();
+  };
+
+  co_await mtx.lock();
+  auto p1 = locker(1), p2 = locker(2), p3 = locker(3);
+  BOOST_CHECK(order.empty());
+  mtx.unlock();
+  // handed over, so it can't be taken in between.
+  BOOST_CHECK(mtx.is_locked());
+  BOOST_CHECK(!mtx.try_lock());
+
+  co_await p1;
+  co_await p2;
+  co_await p3;
+  BOOST_CHECK((order == std::vector<int>{1, 2, 3}));
+  BOOST_CHECK(!mtx.is_locked());
+}
+
+CO_TEST_CASE(cancel)
+{
+  cobalt::mutex mtx;
+  auto locker = [&]() -> cobalt::promise<system::result<void>>
+  {
+    co_return co_await cobalt::as_result(mtx.lock());
+  };
+
+  co_await mtx.lock();
+  auto p1 = locker(), p2 = locker();
+  p1.cancel();
+  auto r1 = co_await p1;
+  BOOST_REQUIRE(r1.has_error());
+  BOOST_CHECK(r1.error() == asio::error::operation_aborted);
+
+  mtx.unlock();
+  auto r2 = co_await p2;
+  BOOST_CHECK(r2.has_value());
+  BOOST_CHECK(mtx.is_locked());
+  mtx.unlock();
+}
+
+CO_TEST_CASE(interrupt)
+{
+  cobalt::mutex mtx;
+  co_await mtx.lock();
+  auto r = co_await cobalt::left_race(mtx.lock(), asio::post(cobalt::use_op));
+  BOOST_CHECK(r.index() == 1u);
+  mtx.unlock();
+  BOOST_CHECK(!mtx.is_locked());
+
+  r = co_await cobalt::left_race(mtx.lock(), asio::post(cobalt::use_op));
+  BOOST_CHECK(r.index() == 0u);
+  BOOST_CHECK(mtx.is_locked());
+  mtx.unlock();
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+BOOST_AUTO_TEST_SUITE(shared_mutex);
+
+CO_TEST_CASE(readers)
+{
+  cobalt::shared_mutex mtx;
+  co_await mtx.lock_shared();
+  co_await mtx.lock_shared();
+  BOOST_CHECK(mtx.shared_count() == 2u);
+  BOOST_CHECK(!mtx.try_lock());
+  mtx.unlock_shared();
+  mtx.unlock_shared();
+  BOOST_CHECK(mtx.try_lock());
+  BOOST_CHECK(!mtx.try_lock_shared());
+  mtx.unlock();
+}
+
+CO_TEST_CASE(fifo)
+{
+  cobalt::shared_mutex mtx;
+  std::vector<int> order;
+  auto writer = [&](int i) -> cobalt::promise<void>
+  {
+    co_await mtx.lock();
+    order.push_back(i);
+    mtx.unlock();
+  };
+  auto reader = [&](int i) -> cobalt::promise<void>
+  {
+    co_await mtx.lock_shared();
+    order.push_back(i);
+    mtx.unlock_shared();
+  };
+
+  co_await mtx.lock_shared();
+  auto w1 = writer(1);
+  // queued behind the writer, even though it's only locked shared.
+  auto r2 = reader(2), r3 = reader(3);
+  auto w4 = writer(4);
+  BOOST_CHECK(!mtx.try_lock_shared());
+  mtx.unlock_shared();
+
+  co_await w1;
+  co_await r2;
+  co_await r3;
+  co_await w4;
+  BOOST_CHECK((order == std::vector<int>{1, 2, 3, 4}));
+  BOOST_CHECK(!mtx.is_locked());
+  BOOST_CHECK(mtx.shared_count() == 0u);
+}
+
+CO_TEST_CASE(cancel_writer)
+{
+  cobalt::shared_mutex mtx;
+  auto writer = [&]() -> cobalt::promise<system::result<void>>
+  {
+    co_return co_await cobalt::as_result(mtx.lock());
+  };
+  auto reader = [&]() -> cobalt::promise<void>
+  {
+    co_await mtx.lock_shared();
+  };
+
+  co_await mtx.lock_shared();
+  auto w = writer();
+  auto r = reader();
+  w.cancel();
+  // the reader was only waiting for the writer.
+  co_await r;
+  BOOST_CHECK(mtx.shared_count() == 2u);
+  BOOST_CHECK((co_await w).has_error());
+  mtx.unlock_shared();
+  mtx.unlock_shared();
+}
+
+BOOST_AUTO_TEST_SUITE_END();
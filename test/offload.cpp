@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/offload.hpp>
+#include <boost/cobalt/op.hpp>
+#include <boost/cobalt/race.hpp>
+#include <boost/cobalt/result.hpp>
+
+#include <boost/asio/steady_timer.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_SUITE(offload);
+
+CO_TEST_CASE(value)
+{
+  const auto main_id = std::this_thread::get_id();
+  auto [n, id] = co_await cobalt::offload(
+      [](int a, int b) {return std::pair(a + b, std::this_thread::get_id());},
+      1, 2);
+  BOOST_CHECK(n == 3);
+  BOOST_CHECK(id != main_id);
+  // resumed on the caller's executor
+  BOOST_CHECK(std::this_thread::get_id() == main_id);
+
+  std::string s = co_await cobalt::offload([](std::string s) {return s + "bar";}, std::string("foo"));
+  BOOST_CHECK(s == "foobar");
+
+  co_await cobalt::offload([]{});
+  BOOST_CHECK(cobalt::get_offload_stats().threads > 0u);
+  BOOST_CHECK(cobalt::get_offload_stats().completed >= 3u);
+  BOOST_CHECK(!cobalt::set_offload_threads(1u));
+}
+
+CO_TEST_CASE(exception)
+{
+  BOOST_CHECK_THROW(co_await cobalt::offload([]{throw std::runtime_error("offload");}), std::runtime_error);
+
+  auto res = co_await cobalt::as_result(cobalt::offload([]() -> int {throw std::runtime_error("offload");}));
+  BOOST_CHECK(res.has_error());
+}
+
+CO_TEST_CASE(cancel)
+{
+  asio::steady_timer tim{co_await cobalt::this_coro::executor, std::chrono::milliseconds(10)};
+  auto r = co_await cobalt::race(
+      cobalt::offload(
+          [](cobalt::offload_token token)
+          {
+            while (!token.cancelled())
+              std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return 42;
+          }),
+      tim.async_wait(cobalt::use_op));
+  BOOST_CHECK(r.index() == 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
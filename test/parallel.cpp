@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/parallel.hpp>
+#include <boost/cobalt/op.hpp>
+#include <boost/cobalt/promise.hpp>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace boost;
+
+namespace
+{
+
+struct counter
+{
+  int running = 0, max_running = 0, calls = 0;
+};
+
+cobalt::promise<int> square(counter & c, int i)
+{
+  c.calls++;
+  c.max_running = (std::max)(c.max_running, ++c.running);
+  co_await asio::post(cobalt::use_op);
+  c.running--;
+  if (i < 0)
+    throw std::runtime_error("negative");
+  co_return i * i;
+}
+
+cobalt::promise<void> accumulate(counter & c, int i, int & sum)
+{
+  sum += co_await square(c, i);
+}
+
+cobalt::promise<void> throw_later()
+{
+  co_await asio::post(cobalt::use_op);
+  throw std::runtime_error("later");
+}
+
+cobalt::promise<void> forever()
+{
+  asio::steady_timer tim{co_await cobalt::this_coro::executor, std::chrono::hours(1)};
+  co_await tim.async_wait(cobalt::use_op);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(parallel);
+
+CO_TEST_CASE(for_each)
+{
+  std::vector<int> input(100);
+  std::iota(input.begin(), input.end(), 0);
+
+  counter c;
+  int sum = 0;
+  co_await cobalt::parallel_for_each(
+      input,
+      [&](int i) {return accumulate(c, i, sum);},
+      4u);
+
+  BOOST_CHECK(c.calls == 100);
+  BOOST_CHECK(c.max_running == 4);
+  BOOST_CHECK(sum == 328350);
+}
+
+CO_TEST_CASE(transform)
+{
+  std::vector<int> input(50);
+  std::iota(input.begin(), input.end(), 0);
+  std::vector<int> output(input.size());
+
+  counter c;
+  co_await cobalt::parallel_transform(input, [&](int i) {return square(c, i);}, output.begin(), 8u);
+
+  BOOST_CHECK(c.max_running == 8);
+  for (std::size_t i = 0u; i < input.size(); i++)
+    BOOST_CHECK(output[i] == input[i] * input[i]);
+}
+
+CO_TEST_CASE(error)
+{
+  std::vector<int> input{1, 2, -3, 4, 5, 6, 7, 8, 9, 10};
+  std::vector<int> output(input.size());
+
+  counter c;
+  BOOST_CHECK_THROW(
+      co_await cobalt::parallel_transform(input, [&](int i) {return square(c, i);}, output.begin(), 2u),
+      std::runtime_error);
+  // no new elements get started after the error
+  BOOST_CHECK(c.calls < 10);
+  BOOST_CHECK(c.running == 0);
+}
+
+CO_TEST_CASE(cancel_rest)
+{
+  std::vector<int> input{0, 1, 2};
+  BOOST_CHECK_THROW(
+      co_await cobalt::parallel_for_each(
+          input,
+          [](int i) {return i == 2 ? throw_later() : forever();},
+          3u),
+      std::runtime_error);
+}
+
+CO_TEST_CASE(empty)
+{
+  std::vector<int> input;
+  co_await cobalt::parallel_for_each(input, [](int) {return forever();}, 4u);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
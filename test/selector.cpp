@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/selector.hpp>
+#include <boost/cobalt/channel.hpp>
+
+#include <boost/asio/steady_timer.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+using namespace boost;
+
+BOOST_AUTO_TEST_SUITE(selector_);
+
+CO_TEST_CASE(round_robin)
+{
+  cobalt::channel<int> a{4u}, b{4u};
+  for (int i = 0; i < 4; i++)
+  {
+    co_await a.write(i);
+    co_await b.write(10 + i);
+  }
+
+  cobalt::selector sel{[&]{return a.read();}, [&]{return b.read();}};
+  for (int i = 0; i < 4; i++)
+  {
+    auto x = co_await sel;
+    BOOST_CHECK(x.index() == 0u);
+    BOOST_CHECK(variant2::get<0>(x) == i);
+    auto y = co_await sel;
+    BOOST_CHECK(y.index() == 1u);
+    BOOST_CHECK(variant2::get<1>(y) == 10 + i);
+  }
+}
+
+CO_TEST_CASE(no_rearm)
+{
+  cobalt::channel<int> a{4u}, b{4u};
+  std::size_t a_cnt = 0u, b_cnt = 0u;
+
+  cobalt::selector sel{[&]{a_cnt++; return a.read();}, [&]{b_cnt++; return b.read();}};
+  for (int i = 0; i < 3; i++)
+  {
+    co_await a.write(i);
+    auto x = co_await sel;
+    BOOST_CHECK(x.index() == 0u);
+    BOOST_CHECK(variant2::get<0>(x) == i);
+  }
+  // b never completed, so its read stayed pending the whole time.
+  BOOST_CHECK(b_cnt == 1u);
+  BOOST_CHECK(a_cnt >= 3u);
+
+  co_await b.write(42);
+  auto y = co_await sel;
+  BOOST_CHECK(y.index() == 1u);
+  BOOST_CHECK(variant2::get<1>(y) == 42);
+}
+
+CO_TEST_CASE(void_source)
+{
+  auto exec = co_await cobalt::this_coro::executor;
+  asio::steady_timer tim{exec};
+  cobalt::channel<int> c{1u};
+
+  cobalt::selector sel{
+    [&]{tim.expires_after(std::chrono::milliseconds(10)); return tim.async_wait(cobalt::use_op);},
+    [&]{return c.read();}};
+
+  auto x = co_await sel;
+  BOOST_CHECK(x.index() == 0u);
+  co_await c.write(1);
+  auto y = co_await sel;
+  BOOST_CHECK(y.index() == 1u);
+}
+
+CO_TEST_CASE(close)
+{
+  cobalt::channel<int> a{4u}, b{4u};
+  co_await a.write(1);
+
+  cobalt::selector sel{[&]{return a.read();}, [&]{return b.read();}};
+  auto x = co_await sel;
+  BOOST_CHECK(x.index() == 0u);
+
+  sel.close();
+  BOOST_CHECK_THROW(co_await sel, boost::system::system_error);
+}
+
+CO_TEST_CASE(cancel)
+{
+  cobalt::channel<int> a{4u};
+  cobalt::selector sel{[&]{return a.read();}};
+
+  auto wait = [](auto & s) -> cobalt::promise<std::size_t> { co_return (co_await s).index(); };
+  auto p = wait(sel);
+  p.cancel();
+  BOOST_CHECK_THROW(co_await p, boost::system::system_error);
+
+  // the pending read survives the cancellation of next()
+  co_await a.write(3);
+  auto x = co_await sel;
+  BOOST_CHECK(variant2::get<0>(x) == 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/semaphore.hpp>
+#include <boost/cobalt/op.hpp>
+#include <boost/cobalt/promise.hpp>
+#include <boost/cobalt/race.hpp>
+
+#include <boost/asio/post.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+#include <vector>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_SUITE(semaphore);
+
+CO_TEST_CASE(available)
+{
+  cobalt::semaphore sem{2u};
+  co_await sem.acquire();
+  BOOST_CHECK(sem.try_acquire());
+  BOOST_CHECK(!sem.try_acquire());
+  BOOST_CHECK(sem.available() == 0u);
+  sem.release(2u);
+  BOOST_CHECK(sem.available() == 2u);
+}
+
+CO_TEST_CASE(fifo)
+{
+  cobalt::semaphore sem;
+  std::vector<int> order;
+  auto acquirer = [&](int i) -> cobalt::promise<void>
+  {
+    co_await sem.acquire();
+    order.push_back(i);
+  };
+
+  auto p1 = acquirer(1), p2 = acquirer(2), p3 = acquirer(3);
+  sem.release(2u);
+  // handed over directly.
+  BOOST_CHECK(sem.available() == 0u);
+  co_await p1;
+  co_await p2;
+  BOOST_CHECK((order == std::vector<int>{1, 2}));
+
+  sem.release(2u);
+  co_await p3;
+  BOOST_CHECK((order == std::vector<int>{1, 2, 3}));
+  BOOST_CHECK(sem.available() == 1u);
+}
+
+CO_TEST_CASE(cancel)
+{
+  cobalt::semaphore sem;
+  auto acquirer = [&]() -> cobalt::promise<system::result<void>>
+  {
+    co_return co_await cobalt::as_result(sem.acquire());
+  };
+
+  auto p1 = acquirer(), p2 = acquirer();
+  p1.cancel();
+  BOOST_CHECK((co_await p1).error() == asio::error::operation_aborted);
+  sem.release();
+  BOOST_CHECK((co_await p2).has_value());
+  BOOST_CHECK(sem.available() == 0u);
+}
+
+CO_TEST_CASE(interrupt)
+{
+  cobalt::semaphore sem;
+  auto r = co_await cobalt::left_race(sem.acquire(), asio::post(cobalt::use_op));
+  BOOST_CHECK(r.index() == 1u);
+  sem.release();
+  BOOST_CHECK(sem.available() == 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/shard.hpp>
+#include <boost/cobalt/switch_to.hpp>
+#include <boost/cobalt/this_thread.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_SUITE(shard_);
+
+BOOST_AUTO_TEST_CASE(run)
+{
+  std::atomic<int> started{0}, pinged{0};
+  const auto main_id = std::this_thread::get_id();
+
+  const int res = cobalt::run_sharded(
+      [&](cobalt::shard & s) -> cobalt::task<int>
+      {
+        BOOST_CHECK(s.count() == 3u);
+        BOOST_CHECK(std::this_thread::get_id() != main_id);
+        started++;
+        // the other shards keep running until all are done, so this always gets delivered.
+        s.post((s.index() + 1u) % s.count(), [&]{pinged++;});
+        co_return s.index() == 1u ? 42 : 0;
+      },
+      cobalt::shard_options{.shards = 3u, .pin = false, .handle_signals = false});
+
+  BOOST_CHECK(res == 42);
+  BOOST_CHECK(started == 3);
+  BOOST_CHECK(pinged == 3);
+}
+
+BOOST_AUTO_TEST_CASE(cross_shard)
+{
+  std::atomic<int> done{0};
+  cobalt::run_sharded(
+      [&](cobalt::shard & s) -> cobalt::task<int>
+      {
+        const auto home = std::this_thread::get_id();
+        std::thread::id remote;
+        if (s.index() == 0u)
+        {
+          co_await cobalt::switch_to(s.get_executor(1u));
+          remote = std::this_thread::get_id();
+          co_await cobalt::switch_to(s.get_executor());
+          BOOST_CHECK(remote != home);
+          BOOST_CHECK(std::this_thread::get_id() == home);
+          done++;
+        }
+        co_return 0;
+      },
+      cobalt::shard_options{.shards = 2u, .pin = false, .handle_signals = false});
+  BOOST_CHECK(done == 1);
+}
+
+BOOST_AUTO_TEST_CASE(exception)
+{
+  BOOST_CHECK_THROW(
+      cobalt::run_sharded(
+          [](cobalt::shard & s) -> cobalt::task<int>
+          {
+            if (s.index() == 1u)
+              throw std::runtime_error("shard");
+            co_return 0;
+          },
+          cobalt::shard_options{.shards = 2u, .pin = false, .handle_signals = false}),
+      std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
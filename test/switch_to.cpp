@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/switch_to.hpp>
+#include <boost/cobalt/promise.hpp>
+
+#include <boost/asio/thread_pool.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+#include <thread>
+
+using namespace boost;
+
+namespace
+{
+
+cobalt::promise<std::thread::id> hop(asio::thread_pool & tp)
+{
+  auto home = co_await cobalt::switch_to(tp.get_executor());
+  const auto id = std::this_thread::get_id();
+  co_await cobalt::switch_to(home);
+  co_return id;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(switch_to);
+
+CO_TEST_CASE(task)
+{
+  asio::thread_pool tp{1u};
+  const auto main_id = std::this_thread::get_id();
+
+  auto home = co_await cobalt::switch_to(tp.get_executor());
+  BOOST_CHECK(std::this_thread::get_id() != main_id);
+  BOOST_CHECK(tp.get_executor().running_in_this_thread());
+  BOOST_CHECK((co_await cobalt::this_coro::executor).target<asio::thread_pool::executor_type>() != nullptr);
+
+  co_await cobalt::switch_to(home);
+  BOOST_CHECK(std::this_thread::get_id() == main_id);
+  BOOST_CHECK((co_await cobalt::this_coro::executor).target<asio::thread_pool::executor_type>() == nullptr);
+  tp.join();
+}
+
+CO_TEST_CASE(promise)
+{
+  asio::thread_pool tp{1u};
+  auto id = co_await hop(tp);
+  BOOST_CHECK(id != std::this_thread::get_id());
+  tp.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END();
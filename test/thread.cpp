@@ -12,6 +12,12 @@
 #include "test.hpp"
 #include "boost/cobalt/spawn.hpp"
 
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
 boost::cobalt::thread thr()
 {
   boost::asio::steady_timer tim{co_await boost::asio::this_coro::executor, std::chrono::milliseconds(100)};
@@ -67,6 +73,18 @@ CO_TEST_CASE(await_thread)
   } catch(...) {}
 }
 
+boost::cobalt::thread thr_immediate()
+{
+  co_return;
+}
+
+// the thread likely finishes between await_ready & await_suspend.
+CO_TEST_CASE(await_finished_thread)
+{
+  for (int i = 0; i < 200; i++)
+    co_await thr_immediate();
+}
+
 boost::cobalt::task<std::thread::id> on_thread()
 {
   co_return std::this_thread::get_id();
@@ -88,5 +106,28 @@ CO_TEST_CASE(spawn_onto_thread)
     t.join();
 }
 
+#if defined(__linux__)
+
+boost::cobalt::thread thr_options(boost::cobalt::thread_options opts, std::string & name)
+{
+  char buf[16];
+  pthread_getname_np(pthread_self(), buf, sizeof(buf));
+  name = buf;
+  co_return;
+}
+
+BOOST_AUTO_TEST_CASE(options)
+{
+  std::string name;
+  boost::cobalt::thread_options opts;
+  opts.name = "cobalt-test-thread";
+  opts.prefault_stack = 64 * 1024;
+  auto t = thr_options(opts, name);
+  t.join();
+  // truncated to 15 chars
+  BOOST_CHECK_EQUAL(name, "cobalt-test-thr");
+}
+
+#endif
 
 BOOST_AUTO_TEST_SUITE_END();
\ No newline at end of file
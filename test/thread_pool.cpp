@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/thread_pool.hpp>
+#include <boost/cobalt/promise.hpp>
+
+#include <boost/asio/steady_timer.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+#include <stdexcept>
+#include <thread>
+
+using namespace boost;
+
+namespace
+{
+
+cobalt::task<std::thread::id> pool_id(int & count)
+{
+  count++;
+  co_return std::this_thread::get_id();
+}
+
+cobalt::task<int> pool_throw()
+{
+  throw std::runtime_error("pool");
+  co_return 0;
+}
+
+cobalt::task<void> pool_sleep()
+{
+  asio::steady_timer tim{co_await cobalt::this_coro::executor, std::chrono::seconds(10)};
+  co_await tim.async_wait(cobalt::use_op);
+}
+
+cobalt::promise<void> run_sleep(cobalt::thread_pool & pool)
+{
+  co_await pool.run(&pool_sleep);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(thread_pool);
+
+CO_TEST_CASE(run)
+{
+  cobalt::thread_pool pool{2u};
+  BOOST_CHECK(pool.size() == 2u);
+  const auto main_id = std::this_thread::get_id();
+
+  int count = 0;
+  auto id1 = co_await pool.run(&pool_id, std::ref(count));
+  auto id2 = co_await pool.run(&pool_id, std::ref(count));
+  BOOST_CHECK(count == 2);
+  BOOST_CHECK(id1 != main_id);
+  BOOST_CHECK(id2 != main_id);
+  // round robin
+  BOOST_CHECK(id1 != id2);
+  BOOST_CHECK(std::this_thread::get_id() == main_id);
+}
+
+CO_TEST_CASE(exception)
+{
+  cobalt::thread_pool pool{1u};
+  BOOST_CHECK_THROW(co_await pool.run(&pool_throw), std::runtime_error);
+}
+
+CO_TEST_CASE(cancel)
+{
+  cobalt::thread_pool pool{1u};
+  auto p = run_sleep(pool);
+  asio::steady_timer tim{co_await cobalt::this_coro::executor, std::chrono::milliseconds(10)};
+  co_await tim.async_wait(cobalt::use_op);
+  p.cancel();
+  BOOST_CHECK_THROW(co_await p, boost::system::system_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -14,6 +14,9 @@
 #include <boost/test/unit_test.hpp>
 #include "test.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+
 using namespace boost;
 
 cobalt::promise<void> gdelay(asio::any_io_executor exec,
@@ -28,6 +31,12 @@ cobalt::promise<void> gdelay(asio::any_io_executor exec,
   co_await tim.async_wait(cobalt::use_op);
 }
 
+cobalt::promise<void> counted(asio::any_io_executor exec, int & running, int & max_running)
+{
+  max_running = (std::max)(max_running, ++running);
+  co_await gdelay(exec, std::chrono::milliseconds(5));
+  running--;
+}
 
 BOOST_AUTO_TEST_SUITE(wait_group);
 
@@ -57,6 +66,87 @@ CO_TEST_CASE(grp)
   BOOST_CHECK(wg.size() == 0u);
 }
 
+CO_TEST_CASE(drain)
+{
+  auto e = co_await cobalt::this_coro::executor;
+
+  cobalt::wait_group wg;
+  for (int i = 0; i < 100; i++)
+    wg.push_back(gdelay(e, std::chrono::milliseconds(i % 5 + 1)));
+  BOOST_CHECK(wg.size() == 100u);
+
+  for (std::size_t i = 100u; i > 0u; i--)
+  {
+    co_await wg.wait_one();
+    BOOST_CHECK(wg.size() == i - 1u);
+  }
+
+  // the nodes get reused.
+  wg.push_back(gdelay(e, std::chrono::milliseconds(1)));
+  co_await wg;
+  BOOST_CHECK(wg.size() == 0u);
+}
+
+CO_TEST_CASE(wait_one_throws)
+{
+  auto e = co_await cobalt::this_coro::executor;
+
+  cobalt::wait_group wg;
+  wg.push_back(gdelay(e, std::chrono::milliseconds::max()));
+  wg.push_back(gdelay(e, std::chrono::milliseconds(1)));
+  BOOST_CHECK_THROW(co_await wg.wait_one(), std::runtime_error);
+  BOOST_CHECK(wg.size() == 1u);
+
+  cobalt::wait_group moved{std::move(wg)};
+  co_await moved.wait_one();
+  BOOST_CHECK(moved.size() == 0u);
+}
+
+CO_TEST_CASE(admission)
+{
+  auto e = co_await cobalt::this_coro::executor;
+
+  int running = 0, max_running = 0;
+  cobalt::wait_group wg{2u};
+  for (int i = 0; i < 6; i++)
+  {
+    co_await wg.admit([&]{return counted(e, running, max_running);});
+    BOOST_CHECK(wg.in_flight() <= 2u);
+  }
+
+  co_await wg;
+  BOOST_CHECK(running == 0);
+  BOOST_CHECK(max_running == 2);
+}
+
+CO_TEST_CASE(deferred)
+{
+  auto e = co_await cobalt::this_coro::executor;
+
+  cobalt::wait_group wg{1u, 1u};
+  BOOST_CHECK(wg.defer([e]{return gdelay(e, std::chrono::milliseconds(5));}));
+  BOOST_CHECK(wg.defer([e]{return gdelay(e, std::chrono::milliseconds(5));}));
+  // the queue is full
+  BOOST_CHECK(!wg.defer([e]{return gdelay(e, std::chrono::milliseconds(5));}));
+  BOOST_CHECK(wg.in_flight() == 1u);
+  BOOST_CHECK(wg.queued() == 1u);
+
+  co_await wg.wait_one();
+  // the deferred task got started when the first one completed.
+  BOOST_CHECK(wg.in_flight() == 1u);
+  BOOST_CHECK(wg.queued() == 0u);
+
+  co_await wg;
+  BOOST_CHECK(wg.size() == 0u);
+}
+
+CO_TEST_CASE(deferred_exception)
+{
+  cobalt::wait_group wg{1u};
+  // a slot is free, so the factory gets invoked by defer, but still reports through wait_one.
+  BOOST_CHECK(wg.defer([]() -> cobalt::promise<void> {throw std::runtime_error("factory");}));
+  BOOST_CHECK_THROW(co_await wg.wait_one(), std::runtime_error);
+}
 
 BOOST_AUTO_TEST_SUITE_END();
 
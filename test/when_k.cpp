@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/when_k.hpp>
+#include <boost/cobalt/channel.hpp>
+#include <boost/cobalt/op.hpp>
+#include <boost/cobalt/promise.hpp>
+
+#include <boost/asio/steady_timer.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+using namespace boost;
+
+static cobalt::promise<std::chrono::milliseconds::rep> replica(
+                                  asio::any_io_executor exec,
+                                  std::chrono::milliseconds ms,
+                                  bool fail = false)
+{
+  asio::steady_timer tim{exec, ms};
+  co_await tim.async_wait(cobalt::use_op);
+  if (fail)
+    throw std::runtime_error("replica");
+  co_return ms.count();
+}
+
+static cobalt::promise<void> wnever()
+{
+  asio::steady_timer tim{cobalt::this_thread::get_executor(),
+                         std::chrono::steady_clock::time_point::max()};
+  co_await tim.async_wait(cobalt::use_op);
+}
+
+BOOST_AUTO_TEST_SUITE(when_k_);
+
+CO_TEST_CASE(variadic)
+{
+  auto exec = co_await asio::this_coro::executor;
+  auto [a, b, c] = co_await cobalt::when_k(2u,
+                                           replica(exec, std::chrono::milliseconds(10)),
+                                           replica(exec, std::chrono::milliseconds(100000)),
+                                           replica(exec, std::chrono::milliseconds(20)));
+  BOOST_CHECK(a == 10);
+  BOOST_CHECK(!b);
+  BOOST_CHECK(c == 20);
+}
+
+CO_TEST_CASE(variadic_impossible)
+{
+  auto exec = co_await asio::this_coro::executor;
+  auto n = wnever();
+  BOOST_CHECK_THROW(
+    co_await cobalt::when_k(2u,
+                            replica(exec, std::chrono::milliseconds(10), true),
+                            replica(exec, std::chrono::milliseconds(20), true),
+                            n),
+    std::runtime_error);
+  // the lvalue promise got interrupted, not cancelled.
+  BOOST_CHECK(!n.ready());
+  n.cancel();
+  co_await cobalt::as_result(n);
+  BOOST_CHECK(n.ready());
+}
+
+CO_TEST_CASE(ranged)
+{
+  auto exec = co_await asio::this_coro::executor;
+  std::vector<cobalt::promise<std::chrono::milliseconds::rep>> vec;
+  vec.push_back(replica(exec, std::chrono::milliseconds(30)));
+  vec.push_back(replica(exec, std::chrono::milliseconds(10), true));
+  vec.push_back(replica(exec, std::chrono::milliseconds(20)));
+  vec.push_back(replica(exec, std::chrono::milliseconds(100000)));
+
+  auto res = co_await cobalt::when_k(2u, vec);
+  BOOST_REQUIRE(res.size() == 2u);
+  BOOST_CHECK(res[0].first == 2u);
+  BOOST_CHECK(res[0].second == 20);
+  BOOST_CHECK(res[1].first == 0u);
+  BOOST_CHECK(res[1].second == 30);
+  // the slow replica got interrupted, i.e. it's still running.
+  BOOST_CHECK(!vec[3].ready());
+  vec[3].cancel();
+}
+
+static cobalt::promise<int> uncancellable(cobalt::channel<int> & chn)
+{
+  // detach from the cancellation of the promise, so it can only be interrupted.
+  co_await cobalt::this_coro::reset_cancellation_source();
+  co_return co_await chn.read();
+}
+
+CO_TEST_CASE(interrupt)
+{
+  auto exec = co_await asio::this_coro::executor;
+  cobalt::channel<int> chn;
+  auto u = uncancellable(chn);
+  auto [a, b] = co_await cobalt::when_k(1u, u, replica(exec, std::chrono::milliseconds(10)));
+  BOOST_CHECK(!a);
+  BOOST_CHECK(b == 10);
+  BOOST_CHECK(!u.ready());
+
+  co_await chn.write(42);
+  BOOST_CHECK(co_await u == 42);
+}
+
+CO_TEST_CASE(ranged_result)
+{
+  auto exec = co_await asio::this_coro::executor;
+  std::vector<cobalt::promise<std::chrono::milliseconds::rep>> vec;
+  vec.push_back(replica(exec, std::chrono::milliseconds(10), true));
+  vec.push_back(replica(exec, std::chrono::milliseconds(20), true));
+  vec.push_back(replica(exec, std::chrono::milliseconds(30)));
+
+  auto res = co_await cobalt::as_result(cobalt::when_k(2u, vec));
+  BOOST_CHECK(res.has_error());
+
+  std::vector<cobalt::promise<std::chrono::milliseconds::rep>> empty;
+  auto [ep, r] = co_await cobalt::as_tuple(cobalt::when_k(1u, empty));
+  BOOST_CHECK(ep);
+  BOOST_CHECK(r.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2025 Klemens Morgenstern (klemens.morgenstern@gmx.net)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/cobalt/with_timeout.hpp>
+#include <boost/cobalt/channel.hpp>
+#include <boost/cobalt/op.hpp>
+#include <boost/cobalt/promise.hpp>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test.hpp"
+
+using namespace boost;
+
+BOOST_AUTO_TEST_SUITE(with_timeout_);
+
+CO_TEST_CASE(completed)
+{
+  asio::steady_timer tim{co_await cobalt::this_coro::executor, std::chrono::milliseconds(5)};
+  auto res = co_await cobalt::with_timeout(tim.async_wait(cobalt::use_op), std::chrono::seconds(10));
+  BOOST_CHECK(res.has_value());
+}
+
+CO_TEST_CASE(timed_out)
+{
+  asio::steady_timer tim{co_await cobalt::this_coro::executor, std::chrono::seconds(10)};
+  const auto start = std::chrono::steady_clock::now();
+  auto res = co_await cobalt::with_timeout(tim.async_wait(cobalt::use_op), std::chrono::milliseconds(10));
+  BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+  BOOST_REQUIRE(res.has_error());
+  BOOST_CHECK(res.error() == asio::error::timed_out);
+
+  // the cancellation state is untouched, so awaiting continues to work.
+  tim.expires_after(std::chrono::milliseconds(1));
+  co_await tim.async_wait(cobalt::use_op);
+}
+
+CO_TEST_CASE(value)
+{
+  cobalt::channel<int> chn{1u};
+  co_await chn.write(42);
+  auto res = co_await cobalt::with_timeout(chn.read(), std::chrono::milliseconds(10));
+  BOOST_REQUIRE(res.has_value());
+  BOOST_CHECK(*res == 42);
+
+  res = co_await cobalt::with_timeout(chn.read(), std::chrono::milliseconds(10));
+  BOOST_CHECK(res.error() == asio::error::timed_out);
+}
+
+CO_TEST_CASE(shared_timer)
+{
+  // the later deadline gets awaited first, so the timer needs to get re-armed for the earlier one.
+  cobalt::channel<int> chn;
+  auto slow = [&]() -> cobalt::promise<system::result<int>>
+      {
+        co_return co_await cobalt::with_timeout(chn.read(), std::chrono::seconds(10));
+      }();
+
+  const auto start = std::chrono::steady_clock::now();
+  auto res = co_await cobalt::with_timeout(chn.read(), std::chrono::milliseconds(10));
+  BOOST_CHECK(res.error() == asio::error::timed_out);
+  BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+
+  co_await chn.write(1);
+  auto r2 = co_await slow;
+  BOOST_CHECK(r2.value() == 1);
+}
+
+cobalt::promise<void> total_cancellation_impl(cobalt::channel<int> & chn)
+{
+  co_await cobalt::this_coro::reset_cancellation_state(asio::enable_total_cancellation());
+
+  // a total cancellation of the awaiting coroutine gets through the filter & gets recorded.
+  BOOST_CHECK_THROW(co_await cobalt::with_timeout(chn.read(), std::chrono::seconds(10)), boost::system::system_error);
+  BOOST_CHECK((co_await cobalt::this_coro::cancelled) == asio::cancellation_type::total);
+
+  co_await cobalt::this_coro::reset_cancellation_state(asio::enable_total_cancellation());
+  auto res = co_await cobalt::with_timeout(chn.read(), std::chrono::seconds(10));
+  BOOST_CHECK(res.value() == 42);
+
+  // the filter is still the same afterwards.
+  asio::steady_timer tim{co_await cobalt::this_coro::executor};
+  for (int i = 0; i < 1000 && !(co_await cobalt::this_coro::cancelled); i++)
+  {
+    tim.expires_after(std::chrono::milliseconds(1));
+    co_await cobalt::as_tuple(tim.async_wait(cobalt::use_op));
+  }
+  BOOST_CHECK((co_await cobalt::this_coro::cancelled) == asio::cancellation_type::total);
+}
+
+CO_TEST_CASE(total_cancellation)
+{
+  cobalt::channel<int> chn;
+  auto p = total_cancellation_impl(chn);
+  p.cancel(asio::cancellation_type::total);
+  co_await chn.write(42);
+  p.cancel(asio::cancellation_type::total);
+  co_await p;
+}
+
+cobalt::task<void> fast_with_long_timeout()
+{
+  auto exec = co_await cobalt::this_coro::executor;
+  auto res = co_await cobalt::with_timeout(asio::post(exec, cobalt::use_op), std::chrono::hours(1));
+  BOOST_CHECK(res.has_value());
+}
+
+// the timer doesn't keep the context busy after the last deadline is gone.
+BOOST_AUTO_TEST_CASE(run_returns)
+{
+  const auto start = std::chrono::steady_clock::now();
+  cobalt::run(fast_with_long_timeout());
+  BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+}
+
+BOOST_AUTO_TEST_SUITE_END();